@@ -0,0 +1,135 @@
+# generate.cmake — Translation units for the compile-time benchmark
+#
+# refinery_generate_compile_bench(<dir> TYPES <n> CHAIN <n> DEPTH <n>)
+# writes one TU per workload into <dir> plus <dir>/manifest.cmake, which
+# records the TU names. run.cmake includes the manifest.
+#
+#   instantiations.cpp  TYPES distinct Refined<long long, Interval<0, k>>
+#                       types, each built once at compile time and once at
+#                       run time
+#   interval_chains.cpp CHAIN arithmetic expressions over interval-refined
+#                       operands; every step uses a fresh operand type, so
+#                       result Interval/Refined types grow with CHAIN
+#   interval_reuse.cpp  CHAIN expressions over a fixed palette of operand
+#                       intervals; result predicates are keyed on their
+#                       bounds, so instantiations stop growing once every
+#                       operand pair has been seen
+#   nesting.cpp         All/Any predicates nested DEPTH levels deep, each
+#                       level used as a Refined predicate
+#   diagnostics.cpp     TYPES reflection-based diagnostic strings
+#                       (display_string_of on values and Refined types), plus
+#                       caught violations where constexpr exceptions exist
+
+function(refinery_generate_compile_bench dir)
+    cmake_parse_arguments(PARSE_ARGV 1 ARG "" "TYPES;CHAIN;DEPTH" "")
+    file(MAKE_DIRECTORY "${dir}")
+    set(header "// Generated by benchmarks/compile/generate.cmake -- do not edit\n")
+    string(APPEND header "#include <refinery/refinery.hpp>\n\n")
+    string(APPEND header "using namespace refinery;\nusing I = long long;\n\n")
+
+    # --- Distinct Refined instantiations
+    set(src "${header}I bench_instantiations(I x) {\n    I sum = 0;\n")
+    foreach(k RANGE 1 ${ARG_TYPES})
+        string(APPEND src
+            "    {\n"
+            "        using R = Refined<I, Interval<0LL, ${k}LL>{}>;\n"
+            "        constexpr R c{${k}LL};\n"
+            "        sum += c.get() + R(x % ${k}LL, runtime_check).get();\n"
+            "    }\n")
+    endforeach()
+    string(APPEND src "    return sum;\n}\n")
+    file(WRITE "${dir}/instantiations.cpp" "${src}")
+
+    # --- Interval arithmetic chains: (a * b + a) * b - a per step
+    set(src "${header}I bench_interval_chains(I x) {\n    I sum = 0;\n")
+    foreach(k RANGE 1 ${ARG_CHAIN})
+        math(EXPR a_lo "-(${k} + 1)")
+        math(EXPR a_hi "${k} + 2")
+        math(EXPR b_lo "-(${k} % 7 + 1)")
+        math(EXPR b_hi "${k} % 11 + 1")
+        string(APPEND src
+            "    {\n"
+            "        const IntervalRefined<I, ${a_lo}LL, ${a_hi}LL> a(x % ${a_hi}LL,\n"
+            "                                                 runtime_check);\n"
+            "        const IntervalRefined<I, ${b_lo}LL, ${b_hi}LL> b(x % ${b_hi}LL,\n"
+            "                                                 runtime_check);\n"
+            "        sum += ((a * b + a) * b - a).get();\n"
+            "    }\n")
+    endforeach()
+    string(APPEND src "    return sum;\n}\n")
+    file(WRITE "${dir}/interval_chains.cpp" "${src}")
+
+    # --- Expressions over a fixed operand palette
+    string(CONCAT src "${header}using Price = IntervalRefined<I, 0LL, 1000000LL>;\n"
+        "using Qty = IntervalRefined<I, 0LL, 1000LL>;\n"
+        "using Fee = IntervalRefined<I, 0LL, 50LL>;\n"
+        "using Rate = IntervalRefined<I, -100LL, 100LL>;\n\n")
+    set(palette Price Qty Fee Rate)
+    foreach(k RANGE 1 ${ARG_CHAIN})
+        math(EXPR p "${k} % 4")
+        math(EXPR q "${k} / 4 % 4")
+        list(GET palette ${p} p)
+        list(GET palette ${q} q)
+        string(APPEND src
+            "I bench_reuse_${k}(I x) {\n"
+            "    const ${p} p(x % 50, runtime_check);\n"
+            "    const ${q} q(x % 40, runtime_check);\n"
+            "    return ((p * q + p) - q).get();\n"
+            "}\n")
+    endforeach()
+    file(WRITE "${dir}/interval_reuse.cpp" "${src}")
+
+    # --- Deep All/Any nesting
+    set(src "${header}inline constexpr auto nest_0 = Positive;\n")
+    foreach(k RANGE 1 ${ARG_DEPTH})
+        math(EXPR prev "${k} - 1")
+        math(EXPR odd "${k} % 2")
+        if(odd)
+            string(APPEND src "inline constexpr auto nest_${k} =\n"
+                "    All<nest_${prev}, Interval<-${k}000LL, ${k}000LL>{}>;\n")
+        else()
+            string(APPEND src "inline constexpr auto nest_${k} =\n"
+                "    Any<nest_${prev}, Even, Interval<-${k}LL, -${k}LL>{}>;\n")
+        endif()
+    endforeach()
+    string(APPEND src "\nI bench_nesting(I x) {\n    I sum = 0;\n")
+    foreach(k RANGE 1 ${ARG_DEPTH})
+        string(APPEND src
+            "    sum += Refined<I, nest_${k}>(x + ${k}, runtime_check).get();\n")
+    endforeach()
+    string(APPEND src "    return sum;\n}\n")
+    file(WRITE "${dir}/nesting.cpp" "${src}")
+
+    # --- Reflection-based diagnostics
+    set(src "${header}")
+    string(APPEND src
+        "consteval std::size_t value_text(I value) {\n"
+        "    return detail::format_value(value).size();\n"
+        "}\n"
+        "template <typename R> consteval std::size_t type_text(const R& r) {\n"
+        "    return std::meta::display_string_of(type_info(r)).size();\n"
+        "}\n\n"
+        "#if defined(__cpp_constexpr_exceptions)\n"
+        "template <auto Pred> consteval bool rejects(I value) {\n"
+        "    try {\n"
+        "        (void)Refined<I, Pred>(value);\n"
+        "    } catch (const std::meta::exception&) {\n"
+        "        return true;\n"
+        "    }\n"
+        "    return false;\n"
+        "}\n"
+        "#endif\n\n")
+    foreach(k RANGE 1 ${ARG_TYPES})
+        string(APPEND src
+            "constexpr Refined<I, Interval<0LL, ${k}LL>{}> diag_${k}{${k}LL};\n"
+            "static_assert(value_text(${k}LL) > 0 && type_text(diag_${k}) > 0);\n"
+            "#if defined(__cpp_constexpr_exceptions)\n"
+            "static_assert(rejects<Interval<0LL, ${k}LL>{}>(-${k}LL));\n"
+            "#endif\n")
+    endforeach()
+    file(WRITE "${dir}/diagnostics.cpp" "${src}")
+
+    file(WRITE "${dir}/manifest.cmake"
+        "set(BENCH_TUS instantiations interval_chains interval_reuse nesting\n"
+        "    diagnostics)\n")
+endfunction()
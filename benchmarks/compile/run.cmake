@@ -0,0 +1,166 @@
+# run.cmake — Compile the generated TUs, record timings, compare to baseline
+#
+# cmake -DBENCH_DIR=<dir> -DCOMPILER=<cxx> "-DFLAGS=<flags>" -DNM=<nm>
+#       -DOUTPUT=<results.json> [-DBASELINE=<baseline.json>]
+#       [-DREPEAT=3] [-DTOLERANCE=15] [-DMIN_DELTA_MS=50]
+#       [-DUPDATE_BASELINE=ON] [-DREQUIRE_BASELINE=ON] -P run.cmake
+#
+# Each TU is compiled REPEAT times with -ftime-report (GCC format); the
+# fastest run is kept. Recorded per TU:
+#   total_ms          TOTAL wall time
+#   instantiation_ms  "template instantiation" wall time; the only metric
+#                     that sees consteval work such as interval bound
+#                     computation, which never reaches code generation
+#   codegen_symbols   emitted refinery:: symbols (nm)
+#   refined_types     distinct Refined<...> specializations with emitted
+#                     member functions (nm)
+# A TU regresses if a time exceeds the baseline by more than TOLERANCE
+# percent and MIN_DELTA_MS, or if it emits more symbols than the baseline.
+# Without a baseline the results are only recorded, unless REQUIRE_BASELINE
+# is set.
+
+foreach(var BENCH_DIR COMPILER NM OUTPUT)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "run.cmake: ${var} is required")
+    endif()
+endforeach()
+if(NOT DEFINED REPEAT)
+    set(REPEAT 3)
+endif()
+if(NOT DEFINED TOLERANCE)
+    set(TOLERANCE 15)
+endif()
+if(NOT DEFINED MIN_DELTA_MS)
+    set(MIN_DELTA_MS 50)
+endif()
+
+include("${BENCH_DIR}/manifest.cmake")
+separate_arguments(flags UNIX_COMMAND "${FLAGS}")
+
+# "1.234" seconds -> "1234" milliseconds
+function(_seconds_to_ms out seconds)
+    if(seconds MATCHES "^([0-9]+)\\.([0-9]*)$")
+        string(SUBSTRING "${CMAKE_MATCH_2}000" 0 3 frac)
+        math(EXPR ms "${CMAKE_MATCH_1} * 1000 + 1${frac} - 1000")
+    else()
+        math(EXPR ms "${seconds} * 1000")
+    endif()
+    set(${out} ${ms} PARENT_SCOPE)
+endfunction()
+
+# Wall time (ms) of the -ftime-report row named `row`; -1 if absent
+function(_report_wall out report row)
+    string(REGEX REPLACE "\\([ 0-9]+%\\)" "" report "${report}")
+    if(report MATCHES "\n *${row} *: *[0-9.]+ +[0-9.]+ +([0-9.]+)")
+        _seconds_to_ms(ms "${CMAKE_MATCH_1}")
+        set(${out} ${ms} PARENT_SCOPE)
+    else()
+        set(${out} -1 PARENT_SCOPE)
+    endif()
+endfunction()
+
+set(results "{}")
+foreach(tu IN LISTS BENCH_TUS)
+    set(src "${BENCH_DIR}/${tu}.cpp")
+    set(obj "${BENCH_DIR}/${tu}.o")
+    set(best_total "")
+    foreach(i RANGE 1 ${REPEAT})
+        execute_process(
+            COMMAND "${COMPILER}" ${flags} -ftime-report -c "${src}" -o "${obj}"
+            RESULT_VARIABLE rc
+            OUTPUT_QUIET
+            ERROR_VARIABLE report)
+        if(NOT rc EQUAL 0)
+            message(FATAL_ERROR "${tu}.cpp failed to compile:\n${report}")
+        endif()
+        _report_wall(total "${report}" "TOTAL")
+        _report_wall(inst "${report}" "template instantiation")
+        if(total LESS 0)
+            message(FATAL_ERROR
+                "No -ftime-report TOTAL row for ${tu}.cpp (GCC required)")
+        endif()
+        if(best_total STREQUAL "" OR total LESS best_total)
+            set(best_total ${total})
+            set(best_inst ${inst})
+        endif()
+    endforeach()
+
+    execute_process(
+        COMMAND "${NM}" -C --defined-only "${obj}"
+        OUTPUT_VARIABLE syms
+        RESULT_VARIABLE rc)
+    if(NOT rc EQUAL 0)
+        message(FATAL_ERROR "${NM} failed on ${obj}")
+    endif()
+    string(REGEX MATCHALL "[^\n]*refinery::[^\n]*" refinery_syms "${syms}")
+    list(LENGTH refinery_syms codegen_symbols)
+
+    # The class of a member symbol runs up to its member name; matching
+    # greedily keeps nested predicate spellings intact
+    set(types "")
+    foreach(sym IN LISTS refinery_syms)
+        if(sym MATCHES "^[0-9a-fA-F]* +[A-Za-z] refinery::Refined<(.*)>::(Refined|get|release|is_valid|emplace|operator)")
+            list(APPEND types "${CMAKE_MATCH_1}")
+        endif()
+    endforeach()
+    list(REMOVE_DUPLICATES types)
+    list(LENGTH types refined_types)
+
+    string(JSON results SET "${results}" "${tu}"
+        "{\"total_ms\": ${best_total}, \"instantiation_ms\": ${best_inst}, \
+\"codegen_symbols\": ${codegen_symbols}, \"refined_types\": ${refined_types}}")
+    message(STATUS "${tu}: ${best_total} ms total, ${best_inst} ms "
+        "instantiation, ${codegen_symbols} symbols, ${refined_types} types")
+endforeach()
+
+file(WRITE "${OUTPUT}" "${results}\n")
+message(STATUS "Results written to ${OUTPUT}")
+
+if(UPDATE_BASELINE)
+    if(NOT BASELINE)
+        message(FATAL_ERROR "UPDATE_BASELINE requires BASELINE")
+    endif()
+    file(WRITE "${BASELINE}" "${results}\n")
+    message(STATUS "Baseline updated: ${BASELINE}")
+    return()
+endif()
+
+if(NOT BASELINE OR NOT EXISTS "${BASELINE}")
+    if(REQUIRE_BASELINE)
+        message(FATAL_ERROR "No baseline at ${BASELINE}; run the "
+            "refinery-compile-bench-baseline target to record one")
+    endif()
+    message(STATUS "No baseline; run the refinery-compile-bench-baseline "
+        "target to record one")
+    return()
+endif()
+
+file(READ "${BASELINE}" baseline)
+set(regressions "")
+foreach(tu IN LISTS BENCH_TUS)
+    string(JSON base ERROR_VARIABLE missing GET "${baseline}" "${tu}")
+    if(missing)
+        message(STATUS "${tu}: not in baseline, skipped")
+        continue()
+    endif()
+    foreach(metric total_ms instantiation_ms)
+        string(JSON was GET "${base}" ${metric})
+        string(JSON now GET "${results}" "${tu}" ${metric})
+        math(EXPR limit "${was} * (100 + ${TOLERANCE}) / 100")
+        math(EXPR delta "${now} - ${was}")
+        if(now GREATER limit AND delta GREATER MIN_DELTA_MS)
+            list(APPEND regressions "${tu}.${metric}: ${was} -> ${now} ms")
+        endif()
+    endforeach()
+    string(JSON was GET "${base}" codegen_symbols)
+    string(JSON now GET "${results}" "${tu}" codegen_symbols)
+    if(now GREATER was)
+        list(APPEND regressions "${tu}.codegen_symbols: ${was} -> ${now}")
+    endif()
+endforeach()
+
+if(regressions)
+    list(JOIN regressions "\n  " report)
+    message(FATAL_ERROR "Compile-time regressions:\n  ${report}")
+endif()
+message(STATUS "No compile-time regressions against ${BASELINE}")
@@ -0,0 +1,358 @@
+// refinery_bench.cpp - Runtime cost of refined operations against raw T
+//
+// Usage: refinery-bench [Google Benchmark flags]
+//   e.g. --benchmark_out=refinery_bench.json --benchmark_out_format=json
+//   (the refinery-bench-json target does this)
+//
+// Every refined benchmark has a Raw counterpart doing the same work on plain
+// T, so the interesting number is the ratio within a family. Arguments are
+// {elements, failure percent}: the failing inputs are non-positive values
+// scattered among positive ones at the given rate. Throughput benchmarks
+// report items_per_second over the whole input; Latency benchmarks handle
+// one value per iteration through a dependency chain, so their time per
+// iteration is the latency of one check.
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <refinery/column.hpp>
+#include <refinery/refinery.hpp>
+#include <refinery/vector.hpp>
+
+using namespace refinery;
+
+namespace {
+
+// Deterministic inputs in [1, 1000], negated for `fail_percent` of them
+template <typename T>
+std::vector<T> make_inputs(std::size_t n, std::int64_t fail_percent) {
+    std::mt19937_64 rng(n * 131 + static_cast<std::size_t>(fail_percent));
+    std::uniform_int_distribution<int> magnitude(1, 1000);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::vector<T> values(n);
+    for (auto& v : values) {
+        const T x = static_cast<T>(magnitude(rng));
+        v = percent(rng) < fail_percent ? static_cast<T>(-x) : x;
+    }
+    return values;
+}
+
+// Positive values in [1, 1000], as interval-refined operands
+template <typename T>
+std::vector<IntervalRefined<T, T{1}, T{1000}>> make_operands(std::size_t n) {
+    std::vector<IntervalRefined<T, T{1}, T{1000}>> out;
+    out.reserve(n);
+    for (T v : make_inputs<T>(n, 0)) {
+        out.emplace_back(v, assume_valid);
+    }
+    return out;
+}
+
+void set_counters(benchmark::State& state) {
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["fail_pct"] = static_cast<double>(state.range(1));
+}
+
+void throughput_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "fail_pct"});
+    b->ArgsProduct({{1 << 10, 1 << 14, 1 << 18}, {0, 1, 10, 50}});
+}
+
+void size_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "fail_pct"});
+    b->ArgsProduct({{1 << 10, 1 << 14, 1 << 18}, {0}});
+}
+
+// Inputs cycled through by the latency benchmarks (a power of two)
+constexpr std::size_t latency_window = 1 << 10;
+
+void latency_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "fail_pct"});
+    b->ArgsProduct({{latency_window}, {0, 10, 50}});
+}
+
+// --- Construction: raw branch vs runtime_check vs try_refine
+
+template <typename T> void BM_Check_Raw(benchmark::State& state) {
+    const auto inputs = make_inputs<T>(state.range(0), state.range(1));
+    for (auto _ : state) {
+        T sum{};
+        std::size_t failed = 0;
+        for (T v : inputs) {
+            if (v > 0) {
+                sum += v;
+            } else {
+                ++failed;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+        benchmark::DoNotOptimize(failed);
+    }
+    set_counters(state);
+}
+
+template <typename T> void BM_Check_RuntimeCheck(benchmark::State& state) {
+    const auto inputs = make_inputs<T>(state.range(0), state.range(1));
+    for (auto _ : state) {
+        T sum{};
+        std::size_t failed = 0;
+        for (T v : inputs) {
+            try {
+                sum += Refined<T, Positive>(v, runtime_check).get();
+            } catch (const refinement_error&) {
+                ++failed;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+        benchmark::DoNotOptimize(failed);
+    }
+    set_counters(state);
+}
+
+template <typename T> void BM_Check_TryRefine(benchmark::State& state) {
+    const auto inputs = make_inputs<T>(state.range(0), state.range(1));
+    for (auto _ : state) {
+        T sum{};
+        std::size_t failed = 0;
+        for (T v : inputs) {
+            if (auto r = try_refine<Refined<T, Positive>>(v)) {
+                sum += r->get();
+            } else {
+                ++failed;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+        benchmark::DoNotOptimize(failed);
+    }
+    set_counters(state);
+}
+
+// --- Latency: one check per iteration; the next index depends on the
+// checked value (0 on failure), so checks cannot overlap
+
+template <typename T> std::size_t next_index(std::size_t i, T checked) {
+    return (i + 1 + static_cast<std::size_t>(checked)) & (latency_window - 1);
+}
+
+template <typename T> void BM_Latency_Raw(benchmark::State& state) {
+    const auto inputs = make_inputs<T>(latency_window, state.range(1));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const T v = inputs[i];
+        i = next_index(i, v > 0 ? v : T{});
+        benchmark::DoNotOptimize(i);
+    }
+    state.counters["fail_pct"] = static_cast<double>(state.range(1));
+}
+
+template <typename T> void BM_Latency_RuntimeCheck(benchmark::State& state) {
+    const auto inputs = make_inputs<T>(latency_window, state.range(1));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        T checked{};
+        try {
+            checked = Refined<T, Positive>(inputs[i], runtime_check).get();
+        } catch (const refinement_error&) {
+        }
+        i = next_index(i, checked);
+        benchmark::DoNotOptimize(i);
+    }
+    state.counters["fail_pct"] = static_cast<double>(state.range(1));
+}
+
+template <typename T> void BM_Latency_TryRefine(benchmark::State& state) {
+    const auto inputs = make_inputs<T>(latency_window, state.range(1));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto r = try_refine<Refined<T, Positive>>(inputs[i]);
+        i = next_index(i, r ? r->get() : T{});
+        benchmark::DoNotOptimize(i);
+    }
+    state.counters["fail_pct"] = static_cast<double>(state.range(1));
+}
+
+// --- Interval operators (integral results are overflow checked)
+
+// Each term fits in T, but their sum over 2^18 elements does not fit in
+// int32_t
+template <typename T>
+using sum_type = std::conditional_t<std::is_integral_v<T>, std::int64_t, T>;
+
+template <typename T> void BM_Interval_Raw(benchmark::State& state) {
+    const auto a = make_inputs<T>(state.range(0), 0);
+    const auto b = make_inputs<T>(state.range(0) + 1, 0);
+    for (auto _ : state) {
+        sum_type<T> sum{};
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            sum += a[i] * b[i] + a[i] - b[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters(state);
+}
+
+template <typename T> void BM_Interval_Refined(benchmark::State& state) {
+    const auto a = make_operands<T>(state.range(0));
+    const auto b = make_operands<T>(state.range(0) + 1);
+    for (auto _ : state) {
+        sum_type<T> sum{};
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            sum += (a[i] * b[i] + a[i] - b[i]).get();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters(state);
+}
+
+// --- safe_divide against plain division
+
+template <typename T> void BM_Divide_Raw(benchmark::State& state) {
+    const auto num = make_inputs<T>(state.range(0), 0);
+    const auto den = make_inputs<T>(state.range(0) + 1, 0);
+    for (auto _ : state) {
+        T sum{};
+        for (std::size_t i = 0; i < num.size(); ++i) {
+            sum += num[i] / den[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters(state);
+}
+
+template <typename T> void BM_Divide_SafeDivide(benchmark::State& state) {
+    const auto num = make_inputs<T>(state.range(0), 0);
+    std::vector<Refined<T, NonZero>> den;
+    for (T v : make_inputs<T>(state.range(0) + 1, 0)) {
+        den.emplace_back(v, assume_valid);
+    }
+    for (auto _ : state) {
+        T sum{};
+        for (std::size_t i = 0; i < num.size(); ++i) {
+            sum += safe_divide(num[i], den[i]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters(state);
+}
+
+// --- Composed predicates: raw, compile-time All, runtime::AllOf
+
+template <typename T> void BM_Compose_Raw(benchmark::State& state) {
+    const auto inputs = make_inputs<T>(state.range(0), state.range(1));
+    for (auto _ : state) {
+        std::size_t valid = 0;
+        for (T v : inputs) {
+            valid += (v > 0 && v < T{500}) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(valid);
+    }
+    set_counters(state);
+}
+
+template <typename T> void BM_Compose_All(benchmark::State& state) {
+    const auto inputs = make_inputs<T>(state.range(0), state.range(1));
+    constexpr auto pred = All<Positive, LessThan(T{500})>;
+    for (auto _ : state) {
+        std::size_t valid = 0;
+        for (T v : inputs) {
+            valid += pred(v) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(valid);
+    }
+    set_counters(state);
+}
+
+template <typename T> void BM_Compose_RuntimeAllOf(benchmark::State& state) {
+    const auto inputs = make_inputs<T>(state.range(0), state.range(1));
+    const runtime::AllOf<T> pred(Positive, LessThan(T{500}));
+    for (auto _ : state) {
+        std::size_t valid = 0;
+        for (T v : inputs) {
+            valid += pred(v) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(valid);
+    }
+    set_counters(state);
+}
+
+// --- Bulk validation: copy and classify a whole buffer
+
+template <typename T> void BM_Bulk_Raw(benchmark::State& state) {
+    const auto inputs = make_inputs<T>(state.range(0), state.range(1));
+    for (auto _ : state) {
+        std::vector<T> copy(inputs);
+        std::size_t valid = 0;
+        for (T v : copy) {
+            valid += v > 0 ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(copy.data());
+        benchmark::DoNotOptimize(valid);
+    }
+    set_counters(state);
+}
+
+template <typename T> void BM_Bulk_RefinedColumn(benchmark::State& state) {
+    const auto inputs = make_inputs<T>(state.range(0), state.range(1));
+    for (auto _ : state) {
+        RefinedColumn<T, Positive> column{std::vector<T>(inputs)};
+        benchmark::DoNotOptimize(column.valid_count());
+    }
+    set_counters(state);
+}
+
+template <typename T> void BM_Bulk_RawAssign(benchmark::State& state) {
+    const auto inputs = make_inputs<T>(state.range(0), 0);
+    std::vector<T> target;
+    for (auto _ : state) {
+        target.assign(inputs.begin(), inputs.end());
+        benchmark::DoNotOptimize(target.data());
+    }
+    set_counters(state);
+}
+
+template <typename T>
+void BM_Bulk_RefinedVectorAssign(benchmark::State& state) {
+    const auto inputs = make_inputs<T>(state.range(0), 0);
+    RefinedVector<T, Positive> target;
+    for (auto _ : state) {
+        target.assign(std::span<const T>(inputs));
+        benchmark::DoNotOptimize(target.size());
+    }
+    set_counters(state);
+}
+
+} // namespace
+
+#define REFINERY_BENCH(name, args)                                             \
+    BENCHMARK_TEMPLATE(name, std::int32_t)->Apply(args);                       \
+    BENCHMARK_TEMPLATE(name, std::int64_t)->Apply(args);                       \
+    BENCHMARK_TEMPLATE(name, double)->Apply(args)
+
+REFINERY_BENCH(BM_Check_Raw, throughput_args);
+REFINERY_BENCH(BM_Check_RuntimeCheck, throughput_args);
+REFINERY_BENCH(BM_Check_TryRefine, throughput_args);
+
+REFINERY_BENCH(BM_Latency_Raw, latency_args);
+REFINERY_BENCH(BM_Latency_RuntimeCheck, latency_args);
+REFINERY_BENCH(BM_Latency_TryRefine, latency_args);
+
+REFINERY_BENCH(BM_Interval_Raw, size_args);
+REFINERY_BENCH(BM_Interval_Refined, size_args);
+
+REFINERY_BENCH(BM_Divide_Raw, size_args);
+REFINERY_BENCH(BM_Divide_SafeDivide, size_args);
+
+REFINERY_BENCH(BM_Compose_Raw, throughput_args);
+REFINERY_BENCH(BM_Compose_All, throughput_args);
+REFINERY_BENCH(BM_Compose_RuntimeAllOf, throughput_args);
+
+REFINERY_BENCH(BM_Bulk_Raw, throughput_args);
+REFINERY_BENCH(BM_Bulk_RefinedColumn, throughput_args);
+REFINERY_BENCH(BM_Bulk_RawAssign, size_args);
+REFINERY_BENCH(BM_Bulk_RefinedVectorAssign, size_args);
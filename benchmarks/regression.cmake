@@ -0,0 +1,398 @@
+# regression.cmake — Run a benchmark, compare its results to a baseline
+#
+# Runtime (refinery-bench):
+#   cmake -DKIND=runtime -DBENCH=<refinery-bench> -DOUTPUT=<results.json>
+#         -DBASELINE=<baseline.json> [-DCOMPILER_ID=<id version>]
+#         [-DFILTER=<regex>] [-DREPETITIONS=5] [-DMIN_TIME=0.05s]
+#         [-DOVERHEAD_TOLERANCE=15] [-DTIME_TOLERANCE=0]
+#         [-DALLOW_COMPILER_MISMATCH=ON] [-DUPDATE_BASELINE=ON]
+#         -P regression.cmake
+#
+# Assembly cost (scripts/compare_asm.sh --report):
+#   cmake -DKIND=asm -DSCRIPT=<compare_asm.sh> -DBUILD_DIR=<dir>
+#         -DPREFIX=<prefix> -DEXAMPLES=<a,b,...> -DOUTPUT=<results.json>
+#         -DBASELINE=<baseline.json> [-DCOMPILER_ID=<id version>]
+#         [-DINSN_SLACK=0] [-DBRANCH_SLACK=0] [-DRTHROUGHPUT_SLACK=0.1]
+#         [-DALLOW_COMPILER_MISMATCH=ON] [-DUPDATE_BASELINE=ON]
+#         -P regression.cmake
+#
+# Both write {"compiler": ..., "entries": {<key>: {<metric>: ...}}} to OUTPUT
+# (and to BASELINE with UPDATE_BASELINE) and fail on any regression, on any
+# baseline entry the run no longer produces (for runtime, among those
+# matching FILTER), and on a baseline recorded by another compiler unless
+# ALLOW_COMPILER_MISMATCH is set. A missing baseline is a failure too, so the
+# gate cannot pass without comparing anything. Runtime benchmarks run
+# REPETITIONS times, randomly interleaved, and the fastest repetition counts.
+# Metrics:
+#   runtime  overhead     cpu_time over the Raw counterpart of the same
+#                         family, type and arguments (BM_<Family>_Raw<Word>
+#                         if the variant ends in <Word>, else BM_<Family>_Raw)
+#                         grew by more than OVERHEAD_TOLERANCE percent, or
+#                         by more than noise_pct (slowest over fastest
+#                         repetition of the variant plus that of the Raw
+#                         run) in the baseline or the current run if larger,
+#                         but never by more than twice OVERHEAD_TOLERANCE
+#            cpu_time     cpu_time (ns) grew by more than
+#                         TIME_TOLERANCE percent; 0 disables this check,
+#                         since absolute times only compare on one machine
+#   asm      status       a pair that was PASS (identical code) no longer is
+#            insn_delta   refined minus plain hot-path instructions grew by
+#                         more than INSN_SLACK
+#            branch_delta likewise for branches, BRANCH_SLACK
+#            rthroughput_delta  llvm-mca block reciprocal throughput delta
+#                         grew by more than RTHROUGHPUT_SLACK cycles (skipped
+#                         when either side was measured without llvm-mca)
+
+cmake_minimum_required(VERSION 3.20)
+
+foreach(var KIND OUTPUT BASELINE)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "regression.cmake: ${var} is required")
+    endif()
+endforeach()
+if(NOT DEFINED COMPILER_ID)
+    set(COMPILER_ID "unknown")
+endif()
+if(NOT DEFINED OVERHEAD_TOLERANCE)
+    set(OVERHEAD_TOLERANCE 15)
+endif()
+if(NOT DEFINED RTHROUGHPUT_SLACK)
+    set(RTHROUGHPUT_SLACK 0.1)
+endif()
+foreach(var TIME_TOLERANCE INSN_SLACK BRANCH_SLACK)
+    if(NOT DEFINED ${var})
+        set(${var} 0)
+    endif()
+endforeach()
+
+# Decimal or scientific number -> integer thousandths (truncated)
+function(_milli out value)
+    if(NOT value MATCHES
+            "^(-?)([0-9]*)\\.?([0-9]*)([eE]([-+]?[0-9]+))?$")
+        message(FATAL_ERROR "regression.cmake: not a number: '${value}'")
+    endif()
+    set(sign "${CMAKE_MATCH_1}")
+    set(digits "${CMAKE_MATCH_2}${CMAKE_MATCH_3}")
+    string(LENGTH "${CMAKE_MATCH_3}" frac_len)
+    set(exponent 0)
+    if(NOT CMAKE_MATCH_5 STREQUAL "")
+        string(REGEX REPLACE "^\\+" "" exponent "${CMAKE_MATCH_5}")
+    endif()
+    math(EXPR shift "${exponent} + 3 - ${frac_len}")
+    if(shift GREATER_EQUAL 0)
+        string(REPEAT "0" ${shift} zeros)
+        string(APPEND digits "${zeros}")
+    else()
+        string(LENGTH "${digits}" len)
+        math(EXPR keep "${len} + ${shift}")
+        if(keep GREATER 0)
+            string(SUBSTRING "${digits}" 0 ${keep} digits)
+        else()
+            set(digits "0")
+        endif()
+    endif()
+    string(REGEX REPLACE "^0+" "" digits "${digits}")
+    if(digits STREQUAL "")
+        set(${out} 0 PARENT_SCOPE)
+    else()
+        set(${out} "${sign}${digits}" PARENT_SCOPE)
+    endif()
+endfunction()
+
+# Integer thousandths -> "1.234"
+function(_format_milli out milli)
+    set(sign "")
+    if(milli LESS 0)
+        set(sign "-")
+        math(EXPR milli "-(${milli})")
+    endif()
+    math(EXPR whole "${milli} / 1000")
+    math(EXPR frac "${milli} % 1000 + 1000")
+    string(SUBSTRING "${frac}" 1 3 frac)
+    set(${out} "${sign}${whole}.${frac}" PARENT_SCOPE)
+endfunction()
+
+# Integer thousandths -> shortest decimal ("0.5", "-2")
+function(_short_milli out milli)
+    _format_milli(text ${milli})
+    string(REGEX REPLACE "0+$" "" text "${text}")
+    string(REGEX REPLACE "\\.$" "" text "${text}")
+    set(${out} "${text}" PARENT_SCOPE)
+endfunction()
+
+# --- Run the benchmark and reduce its output to {key: {metric: value}}
+
+set(entries "")
+if(KIND STREQUAL "runtime")
+    if(NOT DEFINED BENCH)
+        message(FATAL_ERROR "regression.cmake: BENCH is required")
+    endif()
+    if(NOT DEFINED REPETITIONS)
+        set(REPETITIONS 5)
+    endif()
+    if(NOT DEFINED MIN_TIME)
+        set(MIN_TIME 0.05s)
+    endif()
+    set(raw_output "${OUTPUT}.benchmark.json")
+    set(bench_args
+        --benchmark_out=${raw_output}
+        --benchmark_out_format=json
+        --benchmark_min_time=${MIN_TIME}
+        --benchmark_repetitions=${REPETITIONS}
+        --benchmark_enable_random_interleaving=true
+        --benchmark_display_aggregates_only=true)
+    if(FILTER)
+        list(APPEND bench_args --benchmark_filter=${FILTER})
+    endif()
+    execute_process(
+        COMMAND "${BENCH}" ${bench_args}
+        RESULT_VARIABLE rc
+        OUTPUT_QUIET)
+    if(NOT rc EQUAL 0)
+        message(FATAL_ERROR "${BENCH} failed (${rc})")
+    endif()
+
+    # Counters of the cv aggregate can be NaN, which is not valid JSON
+    file(READ "${raw_output}" report)
+    string(REGEX REPLACE ": -?(NaN|nan|inf|Infinity)([,\n])" ": null\\2"
+        report "${report}")
+    string(JSON runs GET "${report}" benchmarks)
+    # Runs are flat objects; parsing them one by one avoids re-parsing the
+    # whole array for every index
+    string(REGEX MATCHALL "{[^{}]*}" runs "${runs}")
+
+    # Fastest repetition's cpu_time in thousandths of a nanosecond, per run
+    # name; the minimum is the run least disturbed by the rest of the system
+    set(names "")
+    foreach(run IN LISTS runs)
+        string(JSON run_type GET "${run}" run_type)
+        if(NOT run_type STREQUAL "iteration")
+            continue()
+        endif()
+        string(JSON name GET "${run}" run_name)
+        string(JSON cpu GET "${run}" cpu_time)
+        string(JSON unit GET "${run}" time_unit)
+        _milli(cpu "${cpu}")
+        if(unit STREQUAL "us")
+            math(EXPR cpu "${cpu} * 1000")
+        elseif(unit STREQUAL "ms")
+            math(EXPR cpu "${cpu} * 1000000")
+        elseif(unit STREQUAL "s")
+            math(EXPR cpu "${cpu} * 1000000000")
+        endif()
+        string(MAKE_C_IDENTIFIER "${name}" id)
+        if(NOT DEFINED cpu_${id})
+            list(APPEND names "${name}")
+            set(cpu_${id} ${cpu})
+            set(max_${id} ${cpu})
+        elseif(cpu LESS cpu_${id})
+            set(cpu_${id} ${cpu})
+        elseif(cpu GREATER max_${id})
+            set(max_${id} ${cpu})
+        endif()
+    endforeach()
+
+    # Spread between the slowest and fastest repetition, in percent
+    foreach(name IN LISTS names)
+        string(MAKE_C_IDENTIFIER "${name}" id)
+        set(spread_${id} 0)
+        if(cpu_${id} GREATER 0)
+            math(EXPR spread_${id}
+                "(${max_${id}} - ${cpu_${id}}) * 100 / ${cpu_${id}}")
+        endif()
+    endforeach()
+
+    foreach(name IN LISTS names)
+        string(MAKE_C_IDENTIFIER "${name}" id)
+        _format_milli(cpu_text ${cpu_${id}})
+        set(entry "\"cpu_time\": ${cpu_text}")
+        set(variant "")
+        if(name MATCHES "^(BM_[A-Za-z0-9]+)_([A-Za-z0-9]+)(<.*)$")
+            set(family "${CMAKE_MATCH_1}")
+            set(variant "${CMAKE_MATCH_2}")
+            set(rest "${CMAKE_MATCH_3}")
+        endif()
+        if(variant AND NOT variant MATCHES "^Raw")
+            set(word "")
+            if(variant MATCHES "([A-Z][a-z0-9]*)$")
+                set(word "${CMAKE_MATCH_1}")
+            endif()
+            string(MAKE_C_IDENTIFIER "${family}_Raw${word}${rest}" raw_id)
+            if(NOT DEFINED cpu_${raw_id})
+                string(MAKE_C_IDENTIFIER "${family}_Raw${rest}" raw_id)
+            endif()
+            if(DEFINED cpu_${raw_id} AND cpu_${raw_id} GREATER 0)
+                math(EXPR overhead
+                    "${cpu_${id}} * 1000 / ${cpu_${raw_id}}")
+                _format_milli(overhead "${overhead}")
+                math(EXPR noise "${spread_${id}} + ${spread_${raw_id}}")
+                string(APPEND entry ", \"overhead\": ${overhead}")
+                string(APPEND entry ", \"noise_pct\": ${noise}")
+            endif()
+        endif()
+        list(APPEND entries "    \"${name}\": {${entry}}")
+    endforeach()
+elseif(KIND STREQUAL "asm")
+    foreach(var SCRIPT BUILD_DIR PREFIX EXAMPLES)
+        if(NOT DEFINED ${var})
+            message(FATAL_ERROR "regression.cmake: ${var} is required")
+        endif()
+    endforeach()
+    string(REPLACE "," ";" examples "${EXAMPLES}")
+    set(raw_output "${OUTPUT}.asm.json")
+    file(REMOVE "${raw_output}")
+    # compare_asm.sh exits 1 whenever a pair differs; known differences
+    # are part of the baseline, so only a missing report is an error
+    execute_process(
+        COMMAND "${SCRIPT}" --report "${raw_output}"
+                "${BUILD_DIR}" "${PREFIX}" ${examples}
+        OUTPUT_VARIABLE log
+        ERROR_VARIABLE log)
+    if(NOT EXISTS "${raw_output}")
+        message(FATAL_ERROR "${SCRIPT} wrote no report:\n${log}")
+    endif()
+    # One pair per line: `  "<example>/<function>": {...},`
+    file(STRINGS "${raw_output}" pairs REGEX "^  \"")
+    foreach(pair IN LISTS pairs)
+        string(REGEX REPLACE ",$" "" pair "${pair}")
+        list(APPEND entries "  ${pair}")
+    endforeach()
+else()
+    message(FATAL_ERROR "regression.cmake: unknown KIND '${KIND}'")
+endif()
+
+list(JOIN entries ",\n" entries)
+set(results "{\n  \"compiler\": \"${COMPILER_ID}\",\n  \"entries\": {\n${entries}\n  }\n}\n")
+file(WRITE "${OUTPUT}" "${results}")
+message(STATUS "Results written to ${OUTPUT}")
+
+if(UPDATE_BASELINE)
+    file(WRITE "${BASELINE}" "${results}")
+    message(STATUS "Baseline updated: ${BASELINE}")
+    return()
+endif()
+
+if(NOT EXISTS "${BASELINE}")
+    message(FATAL_ERROR "No baseline at ${BASELINE}; record one on the "
+        "pinned toolchain with the refinery-perf-baseline target")
+endif()
+
+# --- Compare against the baseline
+
+file(READ "${BASELINE}" baseline)
+string(JSON base_compiler GET "${baseline}" compiler)
+string(JSON base_entries GET "${baseline}" entries)
+string(JSON now_entries GET "${results}" entries)
+
+# Numbers from another compiler say nothing about this change
+if(NOT base_compiler STREQUAL COMPILER_ID)
+    if(NOT ALLOW_COMPILER_MISMATCH)
+        message(FATAL_ERROR "${BASELINE} was recorded with ${base_compiler}, "
+            "this build uses ${COMPILER_ID}; re-record it with the "
+            "refinery-perf-baseline target, or set "
+            "REFINERY_PERF_ALLOW_COMPILER_MISMATCH to compare anyway")
+    endif()
+    message(WARNING "Comparing ${COMPILER_ID} results with a "
+        "${base_compiler} baseline")
+endif()
+
+# Appends to `regressions` if `now` exceeds `was` by more than `percent`
+macro(_check_percent key metric was now percent)
+    _milli(was_m "${was}")
+    _milli(now_m "${now}")
+    math(EXPR limit "${was_m} * (100 + ${percent}) / 100")
+    if(now_m GREATER limit)
+        _short_milli(was_text ${was_m})
+        _short_milli(now_text ${now_m})
+        list(APPEND regressions "${key} ${metric}: ${was_text} -> ${now_text}")
+    endif()
+endmacro()
+
+# Appends to `regressions` if `now` exceeds `was` by more than `slack`
+macro(_check_slack key metric was now slack)
+    _milli(was_m "${was}")
+    _milli(now_m "${now}")
+    _milli(slack_m "${slack}")
+    math(EXPR limit "${was_m} + ${slack_m}")
+    if(now_m GREATER limit)
+        _short_milli(was_text ${was_m})
+        _short_milli(now_text ${now_m})
+        list(APPEND regressions "${key} ${metric}: ${was_text} -> ${now_text}")
+    endif()
+endmacro()
+
+set(regressions "")
+string(JSON count LENGTH "${base_entries}")
+math(EXPR last "${count} - 1")
+foreach(i RANGE ${last})
+    if(count EQUAL 0)
+        break()
+    endif()
+    string(JSON key MEMBER "${base_entries}" ${i})
+    string(JSON base GET "${base_entries}" "${key}")
+    string(JSON now ERROR_VARIABLE missing GET "${now_entries}" "${key}")
+    if(missing)
+        # A filtered run leaves out the benchmarks it does not select
+        if(KIND STREQUAL "runtime" AND FILTER AND NOT key MATCHES "${FILTER}")
+            continue()
+        endif()
+        list(APPEND regressions "${key}: in the baseline but not measured")
+        continue()
+    endif()
+
+    if(KIND STREQUAL "runtime")
+        string(JSON was ERROR_VARIABLE no_overhead GET "${base}" overhead)
+        if(NOT no_overhead)
+            # Differences within the repetition spread of either run are
+            # noise, up to a cap, so a noisy run cannot hide a regression
+            string(JSON cur GET "${now}" overhead)
+            string(JSON base_noise GET "${base}" noise_pct)
+            string(JSON now_noise GET "${now}" noise_pct)
+            set(tolerance ${OVERHEAD_TOLERANCE})
+            foreach(noise ${base_noise} ${now_noise})
+                if(noise GREATER tolerance)
+                    set(tolerance ${noise})
+                endif()
+            endforeach()
+            math(EXPR cap "${OVERHEAD_TOLERANCE} * 2")
+            if(tolerance GREATER cap)
+                set(tolerance ${cap})
+            endif()
+            _check_percent("${key}" overhead ${was} ${cur} ${tolerance})
+        endif()
+        if(TIME_TOLERANCE GREATER 0)
+            string(JSON was GET "${base}" cpu_time)
+            string(JSON cur GET "${now}" cpu_time)
+            _check_percent("${key}" cpu_time ${was} ${cur} ${TIME_TOLERANCE})
+        endif()
+    else()
+        string(JSON was GET "${base}" status)
+        string(JSON cur GET "${now}" status)
+        if(was STREQUAL "PASS" AND NOT cur STREQUAL "PASS")
+            list(APPEND regressions "${key} status: ${was} -> ${cur}")
+        endif()
+        foreach(metric insn_delta branch_delta)
+            string(JSON was GET "${base}" ${metric})
+            string(JSON cur GET "${now}" ${metric})
+            if(metric STREQUAL "insn_delta")
+                _check_slack("${key}" ${metric} ${was} ${cur} ${INSN_SLACK})
+            else()
+                _check_slack("${key}" ${metric} ${was} ${cur} ${BRANCH_SLACK})
+            endif()
+        endforeach()
+        string(JSON was GET "${base}" rthroughput_delta)
+        string(JSON cur GET "${now}" rthroughput_delta)
+        if(NOT was STREQUAL "null" AND NOT cur STREQUAL "null")
+            _check_slack("${key}" rthroughput_delta ${was} ${cur}
+                ${RTHROUGHPUT_SLACK})
+        endif()
+    endif()
+endforeach()
+
+if(regressions)
+    list(JOIN regressions "\n  " report)
+    message(FATAL_ERROR "Performance regressions against ${BASELINE} "
+        "(baseline compiler: ${base_compiler}, now: ${COMPILER_ID}):\n  "
+        "${report}")
+endif()
+message(STATUS "No regressions against ${BASELINE}")
@@ -0,0 +1,164 @@
+// ring_throughput.cpp - Message throughput of SpscRing and MpmcRing
+//
+// Usage: ring_throughput [messages]
+// Prints millions of messages per second for single-element and batched
+// transfers, and for MPMC with 1, 2 and 4 producer/consumer pairs. Threads
+// yield when the ring is full or empty, so results stay meaningful on
+// machines with fewer cores than threads.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <refinery/ring.hpp>
+
+using namespace refinery;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t batch_size = 32;
+
+void report(const char* name, std::uint64_t messages,
+            clock_type::duration elapsed) {
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    std::printf("%-28s %10.1f Mmsg/s\n", name, messages / seconds / 1e6);
+}
+
+std::uint64_t spsc_single(std::uint64_t messages) {
+    SpscRing<std::uint64_t> ring(RingCapacity{1024});
+    std::thread producer([&] {
+        for (std::uint64_t i = 0; i < messages;) {
+            if (ring.try_push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    std::uint64_t sum = 0;
+    for (std::uint64_t received = 0; received < messages;) {
+        if (auto v = ring.try_pop()) {
+            sum += *v;
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    return sum;
+}
+
+std::uint64_t spsc_batched(std::uint64_t messages) {
+    SpscRing<std::uint64_t> ring(RingCapacity{1024});
+    std::thread producer([&] {
+        std::array<std::uint64_t, batch_size> batch;
+        for (std::uint64_t sent = 0; sent < messages;) {
+            const auto n =
+                std::min<std::uint64_t>(batch_size, messages - sent);
+            for (std::size_t i = 0; i < n; ++i) {
+                batch[i] = sent + i;
+            }
+            std::span<const std::uint64_t> pending(batch.data(), n);
+            while (!pending.empty()) {
+                const auto pushed = ring.try_push_n(pending);
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+                pending = pending.subspan(pushed);
+            }
+            sent += n;
+        }
+    });
+    std::uint64_t sum = 0;
+    std::array<std::uint64_t, batch_size> batch;
+    for (std::uint64_t received = 0; received < messages;) {
+        const auto n = ring.try_pop_n(batch);
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += batch[i];
+        }
+        received += n;
+    }
+    producer.join();
+    return sum;
+}
+
+std::uint64_t mpmc(std::uint64_t messages, unsigned pairs) {
+    MpmcRing<std::uint64_t> ring(RingCapacity{1024});
+    const std::uint64_t per_producer = messages / pairs;
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> received{0};
+
+    std::vector<std::thread> threads;
+    for (unsigned p = 0; p < pairs; ++p) {
+        threads.emplace_back([&] {
+            for (std::uint64_t i = 0; i < per_producer;) {
+                if (ring.try_push(i)) {
+                    ++i;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        threads.emplace_back([&] {
+            std::uint64_t local = 0;
+            std::array<std::uint64_t, batch_size> batch;
+            while (received.load(std::memory_order_relaxed) <
+                   per_producer * pairs) {
+                const auto n = ring.try_pop_n(batch);
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                for (std::size_t i = 0; i < n; ++i) {
+                    local += batch[i];
+                }
+                received.fetch_add(n, std::memory_order_relaxed);
+            }
+            sum.fetch_add(local);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    return sum.load();
+}
+
+template <typename F> void run(const char* name, std::uint64_t messages, F f) {
+    const auto start = clock_type::now();
+    const std::uint64_t checksum = f();
+    const auto elapsed = clock_type::now() - start;
+    report(name, messages, elapsed);
+    // Keep the work observable so it cannot be optimized away
+    if (checksum == 1) {
+        std::puts("");
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t messages =
+        argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20'000'000;
+
+    run("spsc try_push/try_pop", messages,
+        [&] { return spsc_single(messages); });
+    run("spsc batched (32)", messages, [&] { return spsc_batched(messages); });
+    for (unsigned pairs : {1u, 2u, 4u}) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "mpmc %uP/%uC", pairs, pairs);
+        run(name, messages, [&] { return mpmc(messages, pairs); });
+    }
+    return 0;
+}
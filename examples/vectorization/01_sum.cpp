@@ -0,0 +1,45 @@
+// 01_sum.cpp — Proves a reduction over std::span<const PositiveI32>
+// vectorizes like the same loop over std::span<const int>
+//
+// Expected: refined_sum and plain_sum are both vectorized (packed paddd) at
+// the same width.
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <refinery/refinery.hpp>
+
+using namespace refinery;
+
+__attribute__((noinline, noipa)) std::int32_t
+refined_sum(std::span<const PositiveI32> values) {
+    std::int32_t sum = 0;
+    for (const auto& v : values) {
+        sum += v.get();
+    }
+    return sum;
+}
+
+__attribute__((noinline, noipa)) std::int32_t
+plain_sum(std::span<const std::int32_t> values) {
+    std::int32_t sum = 0;
+    for (std::int32_t v : values) {
+        sum += v;
+    }
+    return sum;
+}
+
+int main() {
+    std::vector<PositiveI32> refined;
+    std::vector<std::int32_t> plain;
+    for (int i = 0; i < 64; ++i) {
+        refined.emplace_back(i + 1, assume_valid);
+        plain.push_back(i + 1);
+    }
+    volatile std::int32_t sink;
+    sink = refined_sum(refined);
+    sink = plain_sum(plain);
+    (void)sink;
+    return 0;
+}
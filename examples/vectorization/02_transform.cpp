@@ -0,0 +1,66 @@
+// 02_transform.cpp — Proves element-wise transforms from and into refined
+// spans vectorize like the raw float loops
+//
+// refined_scale reads Refined<float, Positive> and writes plain float;
+// refined_normalize writes back into Refined<float, Positive> through
+// assume_valid (x * 0.5f + 1.0f stays positive for positive x).
+//
+// Expected: each refined_* function is vectorized at the same width as its
+// plain_* counterpart (packed mulps/addps).
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <refinery/refinery.hpp>
+
+using namespace refinery;
+
+using PositiveF32 = Refined<float, Positive>;
+
+__attribute__((noinline, noipa)) void
+refined_scale(std::span<const PositiveF32> in, std::span<float> out) {
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        out[i] = in[i].get() * 2.0f + 1.0f;
+    }
+}
+
+__attribute__((noinline, noipa)) void plain_scale(std::span<const float> in,
+                                                  std::span<float> out) {
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        out[i] = in[i] * 2.0f + 1.0f;
+    }
+}
+
+__attribute__((noinline, noipa)) void
+refined_normalize(std::span<const PositiveF32> in,
+                  std::span<PositiveF32> out) {
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        out[i] = PositiveF32(in[i].get() * 0.5f + 1.0f, assume_valid);
+    }
+}
+
+__attribute__((noinline, noipa)) void plain_normalize(std::span<const float> in,
+                                                      std::span<float> out) {
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        out[i] = in[i] * 0.5f + 1.0f;
+    }
+}
+
+int main() {
+    std::vector<PositiveF32> refined;
+    std::vector<float> plain;
+    for (int i = 0; i < 64; ++i) {
+        refined.emplace_back(static_cast<float>(i + 1), assume_valid);
+        plain.push_back(static_cast<float>(i + 1));
+    }
+    std::vector<PositiveF32> refined_out = refined;
+    std::vector<float> out(plain.size());
+    refined_scale(refined, out);
+    plain_scale(plain, out);
+    refined_normalize(refined, refined_out);
+    plain_normalize(plain, out);
+    volatile float sink = out[0] + refined_out[0].get();
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,73 @@
+// 03_compare.cpp — Proves comparisons over refined spans vectorize like raw
+// comparisons
+//
+// refined_count_above counts elements above a threshold (Refined's
+// operator<=> against T); refined_max takes the running maximum.
+//
+// Expected: each refined_* function is vectorized at the same width as its
+// plain_* counterpart (packed pcmpgtd / pmaxsd or blends).
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <refinery/refinery.hpp>
+
+using namespace refinery;
+
+__attribute__((noinline, noipa)) std::size_t
+refined_count_above(std::span<const NonNegativeI32> values,
+                    std::int32_t threshold) {
+    std::size_t count = 0;
+    for (const auto& v : values) {
+        count += v > threshold ? 1 : 0;
+    }
+    return count;
+}
+
+__attribute__((noinline, noipa)) std::size_t
+plain_count_above(std::span<const std::int32_t> values,
+                  std::int32_t threshold) {
+    std::size_t count = 0;
+    for (std::int32_t v : values) {
+        count += v > threshold ? 1 : 0;
+    }
+    return count;
+}
+
+__attribute__((noinline, noipa)) std::int32_t
+refined_max(std::span<const NonNegativeI32> values) {
+    std::int32_t best = 0;
+    for (const auto& v : values) {
+        best = v.get() > best ? v.get() : best;
+    }
+    return best;
+}
+
+__attribute__((noinline, noipa)) std::int32_t
+plain_max(std::span<const std::int32_t> values) {
+    std::int32_t best = 0;
+    for (std::int32_t v : values) {
+        best = v > best ? v : best;
+    }
+    return best;
+}
+
+int main() {
+    std::vector<NonNegativeI32> refined;
+    std::vector<std::int32_t> plain;
+    for (int i = 0; i < 64; ++i) {
+        refined.emplace_back(i, assume_valid);
+        plain.push_back(i);
+    }
+    volatile std::size_t count_sink;
+    volatile std::int32_t max_sink;
+    count_sink = refined_count_above(refined, 10);
+    count_sink = plain_count_above(plain, 10);
+    max_sink = refined_max(refined);
+    max_sink = plain_max(plain);
+    (void)count_sink;
+    (void)max_sink;
+    return 0;
+}
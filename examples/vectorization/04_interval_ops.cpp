@@ -0,0 +1,50 @@
+// 04_interval_ops.cpp — Proves interval arithmetic inside a loop vectorizes
+// like the raw arithmetic
+//
+// (a + b) * c over IntervalRefined<double, 0, 1> yields
+// Refined<double, Interval<0.0, 2.0>>; the result interval is computed at
+// compile time and floating-point operators need no runtime check.
+//
+// Expected: refined_blend and plain_blend are both vectorized at the same
+// width (packed addpd/mulpd).
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <refinery/refinery.hpp>
+
+using namespace refinery;
+
+using Unit = IntervalRefined<double, 0.0, 1.0>;
+
+__attribute__((noinline, noipa)) void
+refined_blend(std::span<const Unit> a, std::span<const Unit> b,
+              std::span<const Unit> c, std::span<double> out) {
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        out[i] = ((a[i] + b[i]) * c[i]).get();
+    }
+}
+
+__attribute__((noinline, noipa)) void
+plain_blend(std::span<const double> a, std::span<const double> b,
+            std::span<const double> c, std::span<double> out) {
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        out[i] = (a[i] + b[i]) * c[i];
+    }
+}
+
+int main() {
+    std::vector<Unit> refined;
+    std::vector<double> plain;
+    for (int i = 0; i < 64; ++i) {
+        refined.emplace_back(i / 64.0, assume_valid);
+        plain.push_back(i / 64.0);
+    }
+    std::vector<double> out(plain.size());
+    refined_blend(refined, refined, refined, out);
+    plain_blend(plain, plain, plain, out);
+    volatile double sink = out[1];
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,289 @@
+// atomic.hpp - Lock-free atomic refined values
+// Part of the C++26 Refinement Types Library
+//
+// AtomicRefined<T, Pred> wraps std::atomic<T> and keeps the invariant that
+// the stored value always satisfies Pred. Loads are free: the value is
+// re-wrapped without a check. Read-modify-write operations compute the new
+// value, check it, and publish it with a compare-exchange loop, so an update
+// that would violate the predicate is refused (or saturated) without ever
+// becoming visible to other threads. When interval math proves that every
+// value of T satisfies Pred, fetch_add/fetch_sub use a single atomic add.
+
+#ifndef REFINERY_ATOMIC_HPP
+#define REFINERY_ATOMIC_HPP
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "core.hpp"
+#include "interval.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+// Alignment used to keep independently updated atomics on separate lines
+inline constexpr std::size_t cache_line_size = 64;
+
+// True if interval math proves every value of T satisfies Pred
+template <typename T, auto Pred> consteval bool accepts_all_values() {
+    if constexpr (interval_predicate<Pred> && std::integral<T>) {
+        return std::cmp_less_equal(Pred.lo, std::numeric_limits<T>::min()) &&
+               std::cmp_greater_equal(Pred.hi, std::numeric_limits<T>::max());
+    } else {
+        return false;
+    }
+}
+
+// Overflow-checked step for CAS loops: stores a + b (or a - b) in `out` and
+// returns false instead of throwing when the result does not fit in T
+template <typename T>
+    requires std::integral<T>
+constexpr bool try_add(T a, T b, T& out) noexcept {
+    if (b > 0 && a > std::numeric_limits<T>::max() - b)
+        return false;
+    if (b < 0 && a < std::numeric_limits<T>::min() - b)
+        return false;
+    out = static_cast<T>(a + b);
+    return true;
+}
+
+template <typename T>
+    requires std::integral<T>
+constexpr bool try_sub(T a, T b, T& out) noexcept {
+    if (b < 0 && a > std::numeric_limits<T>::max() + b)
+        return false;
+    if (b > 0 && a < std::numeric_limits<T>::min() + b)
+        return false;
+    out = static_cast<T>(a - b);
+    return true;
+}
+
+// a + b clamped to the interval [Pred.lo, Pred.hi] (and to the range of T)
+template <auto Pred, typename T>
+    requires interval_predicate<Pred> && std::integral<T>
+constexpr T clamped_add(T a, T b) noexcept {
+    constexpr T lo = static_cast<T>(Pred.lo);
+    constexpr T hi = static_cast<T>(Pred.hi);
+    T sum;
+    if (!try_add(a, b, sum)) {
+        return b > 0 ? hi : lo;
+    }
+    return sum < lo ? lo : (sum > hi ? hi : sum);
+}
+
+// a - b clamped to the interval [Pred.lo, Pred.hi] (and to the range of T)
+template <auto Pred, typename T>
+    requires interval_predicate<Pred> && std::integral<T>
+constexpr T clamped_sub(T a, T b) noexcept {
+    constexpr T lo = static_cast<T>(Pred.lo);
+    constexpr T hi = static_cast<T>(Pred.hi);
+    T diff;
+    if (!try_sub(a, b, diff)) {
+        return b > 0 ? lo : hi;
+    }
+    return diff < lo ? lo : (diff > hi ? hi : diff);
+}
+
+} // namespace detail
+
+template <typename T, auto Pred>
+    requires predicate_for<decltype(Pred), T> &&
+             std::is_trivially_copyable_v<T>
+class AtomicRefined {
+  public:
+    using value_type = T;
+    using refined_type = Refined<T, Pred>;
+    static constexpr auto predicate = Pred;
+    static constexpr bool is_always_lock_free =
+        std::atomic<T>::is_always_lock_free;
+
+    explicit AtomicRefined(refined_type initial) noexcept
+        : value_(initial.get()) {}
+
+    AtomicRefined(const AtomicRefined&) = delete;
+    AtomicRefined& operator=(const AtomicRefined&) = delete;
+
+    // --- Loads and stores: no checks needed
+
+    [[nodiscard]] refined_type
+    load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        return refined_type(value_.load(order), detail::adopt_checked);
+    }
+
+    void store(refined_type desired,
+               std::memory_order order = std::memory_order_seq_cst) noexcept {
+        value_.store(desired.get(), order);
+    }
+
+    refined_type
+    exchange(refined_type desired,
+             std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return refined_type(value_.exchange(desired.get(), order),
+                            detail::adopt_checked);
+    }
+
+    // On failure `expected` is updated to the current (valid) value
+    bool compare_exchange_weak(
+        refined_type& expected, refined_type desired,
+        std::memory_order success = std::memory_order_seq_cst,
+        std::memory_order failure = std::memory_order_seq_cst) noexcept {
+        T raw = expected.get();
+        const bool ok =
+            value_.compare_exchange_weak(raw, desired.get(), success, failure);
+        expected = refined_type(raw, detail::adopt_checked);
+        return ok;
+    }
+
+    bool compare_exchange_strong(
+        refined_type& expected, refined_type desired,
+        std::memory_order success = std::memory_order_seq_cst,
+        std::memory_order failure = std::memory_order_seq_cst) noexcept {
+        T raw = expected.get();
+        const bool ok = value_.compare_exchange_strong(raw, desired.get(),
+                                                       success, failure);
+        expected = refined_type(raw, detail::adopt_checked);
+        return ok;
+    }
+
+    // --- Checked read-modify-write
+
+    // Atomically replace the value with func(current) if that satisfies Pred.
+    // func may be called several times under contention and returns
+    // std::optional<T> (nullopt to give up). Returns the previous value, or
+    // nullopt if the update was refused.
+    template <typename F>
+        requires std::invocable<F&, const T&>
+    std::optional<refined_type>
+    try_update(F func, std::memory_order order = std::memory_order_seq_cst) {
+        T current = value_.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::optional<T> next = func(current);
+            if (!next) {
+                return std::nullopt;
+            }
+            detail::note_construction<refined_type,
+                                      construction::runtime_check>();
+            if (!Pred(*next)) {
+                return std::nullopt;
+            }
+            if (value_.compare_exchange_weak(current, *next, order,
+                                             std::memory_order_relaxed)) {
+                return refined_type(current, detail::adopt_checked);
+            }
+        }
+    }
+
+    // Add `arg` unless the result would overflow T or violate Pred; returns
+    // the previous value, or nullopt (value unchanged) if refused
+    std::optional<refined_type>
+    try_fetch_add(T arg, std::memory_order order = std::memory_order_seq_cst)
+        requires std::integral<T>
+    {
+        return try_update(
+            [arg](T current) -> std::optional<T> {
+                T next;
+                return detail::try_add(current, arg, next)
+                           ? std::optional<T>(next)
+                           : std::nullopt;
+            },
+            order);
+    }
+
+    std::optional<refined_type>
+    try_fetch_sub(T arg, std::memory_order order = std::memory_order_seq_cst)
+        requires std::integral<T>
+    {
+        return try_update(
+            [arg](T current) -> std::optional<T> {
+                T next;
+                return detail::try_sub(current, arg, next)
+                           ? std::optional<T>(next)
+                           : std::nullopt;
+            },
+            order);
+    }
+
+    // Add `arg`, returning the previous value.
+    // If every value of T satisfies Pred this is a single atomic add with
+    // std::atomic wrap-around semantics; otherwise it throws refinement_error
+    // (value unchanged) when the result would overflow T or violate Pred.
+    refined_type fetch_add(T arg,
+                           std::memory_order order = std::memory_order_seq_cst)
+        requires std::integral<T>
+    {
+        if constexpr (detail::accepts_all_values<T, Pred>()) {
+            return refined_type(value_.fetch_add(arg, order),
+                                detail::adopt_checked);
+        } else {
+            if (auto previous = try_fetch_add(arg, order)) {
+                return *previous;
+            }
+            throw refinement_error(
+                "Refinement violation: atomic fetch_add would leave "
+                "predicate");
+        }
+    }
+
+    refined_type fetch_sub(T arg,
+                           std::memory_order order = std::memory_order_seq_cst)
+        requires std::integral<T>
+    {
+        if constexpr (detail::accepts_all_values<T, Pred>()) {
+            return refined_type(value_.fetch_sub(arg, order),
+                                detail::adopt_checked);
+        } else {
+            if (auto previous = try_fetch_sub(arg, order)) {
+                return *previous;
+            }
+            throw refinement_error(
+                "Refinement violation: atomic fetch_sub would leave "
+                "predicate");
+        }
+    }
+
+    // Add `arg`, clamping the result to [Pred.lo, Pred.hi]; returns the
+    // previous value
+    refined_type
+    saturating_fetch_add(T arg,
+                         std::memory_order order = std::memory_order_seq_cst)
+        requires std::integral<T> && interval_predicate<Pred>
+    {
+        T current = value_.load(std::memory_order_relaxed);
+        while (!value_.compare_exchange_weak(
+            current, detail::clamped_add<Pred>(current, arg), order,
+            std::memory_order_relaxed)) {
+        }
+        return refined_type(current, detail::adopt_checked);
+    }
+
+    // Subtract `arg`, clamping the result to [Pred.lo, Pred.hi]
+    refined_type
+    saturating_fetch_sub(T arg,
+                         std::memory_order order = std::memory_order_seq_cst)
+        requires std::integral<T> && interval_predicate<Pred>
+    {
+        T current = value_.load(std::memory_order_relaxed);
+        while (!value_.compare_exchange_weak(
+            current, detail::clamped_sub<Pred>(current, arg), order,
+            std::memory_order_relaxed)) {
+        }
+        return refined_type(current, detail::adopt_checked);
+    }
+
+    [[nodiscard]] bool is_lock_free() const noexcept {
+        return value_.is_lock_free();
+    }
+
+  private:
+    std::atomic<T> value_;
+};
+
+} // namespace refinery
+
+#endif // REFINERY_ATOMIC_HPP
@@ -0,0 +1,98 @@
+// bulk.hpp - Bulk predicate evaluation over contiguous ranges
+// Part of the C++26 Refinement Types Library
+//
+// The loops below are written branch-free over fixed 64-element blocks so
+// that simple predicates (comparisons, interval checks) auto-vectorize.
+
+#ifndef REFINERY_BULK_HPP
+#define REFINERY_BULK_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "core.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+inline constexpr std::size_t bulk_block = 64;
+
+// Number of bytes needed for an LSB-first validity bitmap of n bits
+[[nodiscard]] constexpr std::size_t bitmap_bytes(std::size_t n) noexcept {
+    return (n + 7) / 8;
+}
+
+// Evaluate Pred over `values` and pack the results into `bitmap` starting at
+// bit `first_bit` (LSB-first bit order, as used by Apache Arrow). The bitmap
+// must be zero-initialized from `first_bit` onwards. Returns the number of
+// values satisfying the predicate.
+template <auto Pred, typename T>
+constexpr std::size_t evaluate_bitmap(std::span<const T> values,
+                                      std::uint8_t* bitmap,
+                                      std::size_t first_bit = 0) {
+    const std::size_t n = values.size();
+    std::size_t valid = 0;
+    std::size_t i = 0;
+
+    // Fast path: byte-aligned destination, whole 64-element blocks
+    if (first_bit % 8 == 0) {
+        std::uint8_t* out = bitmap + first_bit / 8;
+        for (; i + bulk_block <= n; i += bulk_block) {
+            std::uint64_t word = 0;
+            for (std::size_t j = 0; j < bulk_block; ++j) {
+                word |= std::uint64_t{static_cast<bool>(Pred(values[i + j]))}
+                        << j;
+            }
+            for (std::size_t k = 0; k < 8; ++k) {
+                out[i / 8 + k] = static_cast<std::uint8_t>(word >> (8 * k));
+            }
+            valid += static_cast<std::size_t>(std::popcount(word));
+        }
+    }
+
+    for (; i < n; ++i) {
+        if (Pred(values[i])) {
+            const std::size_t bit = first_bit + i;
+            bitmap[bit / 8] |= static_cast<std::uint8_t>(1u << (bit % 8));
+            ++valid;
+        }
+    }
+    return valid;
+}
+
+// Index of the first value not satisfying Pred, or values.size() if all do
+template <auto Pred, typename T>
+[[nodiscard]] constexpr std::size_t find_invalid(std::span<const T> values) {
+    const std::size_t n = values.size();
+    std::size_t i = 0;
+    for (; i + bulk_block <= n; i += bulk_block) {
+        bool ok = true;
+        for (std::size_t j = 0; j < bulk_block; ++j) {
+            ok &= static_cast<bool>(Pred(values[i + j]));
+        }
+        if (!ok) {
+            break;
+        }
+    }
+    for (; i < n; ++i) {
+        if (!Pred(values[i])) {
+            return i;
+        }
+    }
+    return n;
+}
+
+// True if every value satisfies Pred
+template <auto Pred, typename T>
+[[nodiscard]] constexpr bool all_satisfy(std::span<const T> values) {
+    return find_invalid<Pred>(values) == values.size();
+}
+
+} // namespace detail
+
+} // namespace refinery
+
+#endif // REFINERY_BULK_HPP
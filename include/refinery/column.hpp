@@ -0,0 +1,350 @@
+// column.hpp - Refined columns with a packed validity bitmap
+// Part of the C++26 Refinement Types Library
+//
+// RefinedColumn<T, Pred> stores raw values next to an Arrow-compatible
+// validity bitmap instead of rejecting a whole batch when one element fails.
+// Bit i is set iff values()[i] satisfies Pred; iteration yields only the
+// valid elements, already wrapped as Refined<T, Pred>.
+
+#ifndef REFINERY_COLUMN_HPP
+#define REFINERY_COLUMN_HPP
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bulk.hpp"
+#include "core.hpp"
+
+// Apache Arrow C data interface (ABI-stable, see
+// https://arrow.apache.org/docs/format/CDataInterface.html). Guarded so it
+// can coexist with Arrow's own definition.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace refinery {
+
+template <typename T, auto Pred>
+    requires predicate_for<decltype(Pred), T>
+class RefinedColumn {
+  public:
+    using value_type = T;
+    using refined_type = Refined<T, Pred>;
+    using size_type = std::size_t;
+    static constexpr auto predicate = Pred;
+
+    // Forward iterator over the valid rows only
+    class iterator {
+      public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = refined_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = refined_type;
+
+        constexpr iterator() = default;
+
+        [[nodiscard]] constexpr refined_type operator*() const {
+            return refined_type(column_->values_[index_],
+                                detail::adopt_checked);
+        }
+
+        constexpr iterator& operator++() {
+            index_ = column_->next_valid(index_ + 1);
+            return *this;
+        }
+
+        constexpr iterator operator++(int) {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        // Row position of the current element within the column
+        [[nodiscard]] constexpr size_type index() const noexcept {
+            return index_;
+        }
+
+        [[nodiscard]] friend constexpr bool operator==(const iterator& lhs,
+                                                       const iterator& rhs) {
+            return lhs.index_ == rhs.index_;
+        }
+
+      private:
+        friend class RefinedColumn;
+
+        constexpr iterator(const RefinedColumn* column, size_type index)
+            : column_(column), index_(index) {}
+
+        const RefinedColumn* column_ = nullptr;
+        size_type index_ = 0;
+    };
+
+    RefinedColumn() = default;
+
+    // Take ownership of raw values and evaluate the predicate over all of them
+    explicit RefinedColumn(std::vector<T> values)
+        : values_(std::move(values)),
+          bitmap_(detail::bitmap_bytes(values_.size()), 0) {
+        detail::note_construction<refined_type, construction::runtime_check>(
+            values_.size());
+        valid_count_ = detail::evaluate_bitmap<Pred>(
+            std::span<const T>(values_), bitmap_.data());
+    }
+
+    explicit RefinedColumn(std::span<const T> values)
+        : RefinedColumn(std::vector<T>(values.begin(), values.end())) {}
+
+    // Adopt values with a precomputed validity bitmap (trusted contexts)
+    // WARNING: Caller is responsible for every set bit satisfying Pred
+    RefinedColumn(std::vector<T> values, std::vector<std::uint8_t> bitmap,
+                  assume_valid_t)
+        : values_(std::move(values)), bitmap_(std::move(bitmap)) {
+        bitmap_.resize(detail::bitmap_bytes(values_.size()), 0);
+        if (values_.size() % 8 != 0) {
+            bitmap_.back() &=
+                static_cast<std::uint8_t>((1u << (values_.size() % 8)) - 1);
+        }
+        for (auto byte : bitmap_) {
+            valid_count_ += static_cast<size_type>(std::popcount(byte));
+        }
+    }
+
+    // Append one value; returns whether it satisfied the predicate
+    bool push_back(T value) {
+        detail::note_construction<refined_type, construction::runtime_check>();
+        const bool valid = static_cast<bool>(Pred(value));
+        const size_type row = values_.size();
+        values_.push_back(std::move(value));
+        if (row % 8 == 0) {
+            bitmap_.push_back(0);
+        }
+        if (valid) {
+            bitmap_[row / 8] |= static_cast<std::uint8_t>(1u << (row % 8));
+            ++valid_count_;
+        }
+        return valid;
+    }
+
+    // Append a value already known to satisfy the predicate
+    void push_back(const refined_type& value) {
+        const size_type row = values_.size();
+        values_.push_back(value.get());
+        if (row % 8 == 0) {
+            bitmap_.push_back(0);
+        }
+        bitmap_[row / 8] |= static_cast<std::uint8_t>(1u << (row % 8));
+        ++valid_count_;
+    }
+
+    // Append a batch of raw values; returns how many were valid
+    size_type append(std::span<const T> values) {
+        const size_type first = values_.size();
+        values_.insert(values_.end(), values.begin(), values.end());
+        bitmap_.resize(detail::bitmap_bytes(values_.size()), 0);
+        const size_type valid =
+            detail::evaluate_bitmap<Pred>(values, bitmap_.data(), first);
+        valid_count_ += valid;
+        return valid;
+    }
+
+    // Release the raw values (including invalid rows), leaving the column
+    // empty
+    [[nodiscard]] std::vector<T> release() && noexcept {
+        bitmap_.clear();
+        valid_count_ = 0;
+        return std::move(values_);
+    }
+
+    void clear() noexcept {
+        values_.clear();
+        bitmap_.clear();
+        valid_count_ = 0;
+    }
+
+    void reserve(size_type n) {
+        values_.reserve(n);
+        bitmap_.reserve(detail::bitmap_bytes(n));
+    }
+
+    [[nodiscard]] size_type size() const noexcept { return values_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return values_.empty(); }
+    [[nodiscard]] size_type valid_count() const noexcept {
+        return valid_count_;
+    }
+    [[nodiscard]] size_type null_count() const noexcept {
+        return values_.size() - valid_count_;
+    }
+
+    [[nodiscard]] bool is_valid(size_type row) const noexcept {
+        return (bitmap_[row / 8] >> (row % 8)) & 1u;
+    }
+
+    // Refined value at `row`, or nullopt if that row failed the predicate
+    [[nodiscard]] std::optional<refined_type> at(size_type row) const {
+        if (row < values_.size() && is_valid(row)) {
+            return refined_type(values_[row], detail::adopt_checked);
+        }
+        return std::nullopt;
+    }
+
+    // Raw values, including the slots of invalid rows
+    [[nodiscard]] std::span<const T> values() const noexcept {
+        return values_;
+    }
+
+    // LSB-first validity bitmap, ceil(size() / 8) bytes
+    [[nodiscard]] std::span<const std::uint8_t>
+    validity_bitmap() const noexcept {
+        return bitmap_;
+    }
+
+    [[nodiscard]] iterator begin() const { return {this, next_valid(0)}; }
+    [[nodiscard]] iterator end() const { return {this, values_.size()}; }
+
+  private:
+    // First valid row at or after `row`, or size() if none
+    [[nodiscard]] size_type next_valid(size_type row) const noexcept {
+        const size_type n = values_.size();
+        while (row < n) {
+            const unsigned bits = bitmap_[row / 8] >> (row % 8);
+            if (bits != 0) {
+                return row + static_cast<size_type>(std::countr_zero(bits));
+            }
+            row = (row / 8 + 1) * 8;
+        }
+        return n;
+    }
+
+    std::vector<T> values_;
+    std::vector<std::uint8_t> bitmap_;
+    size_type valid_count_ = 0;
+};
+
+// --- Arrow C data interface export ---
+
+namespace detail {
+
+// Arrow format string for a primitive value type (nullptr if unsupported)
+template <typename T> consteval const char* arrow_format() {
+    if constexpr (std::same_as<T, std::int8_t>)
+        return "c";
+    else if constexpr (std::same_as<T, std::uint8_t>)
+        return "C";
+    else if constexpr (std::same_as<T, std::int16_t>)
+        return "s";
+    else if constexpr (std::same_as<T, std::uint16_t>)
+        return "S";
+    else if constexpr (std::same_as<T, std::int32_t>)
+        return "i";
+    else if constexpr (std::same_as<T, std::uint32_t>)
+        return "I";
+    else if constexpr (std::same_as<T, std::int64_t>)
+        return "l";
+    else if constexpr (std::same_as<T, std::uint64_t>)
+        return "L";
+    else if constexpr (std::same_as<T, float>)
+        return "f";
+    else if constexpr (std::same_as<T, double>)
+        return "g";
+    else
+        return nullptr;
+}
+
+template <typename T>
+concept arrow_primitive = arrow_format<T>() != nullptr;
+
+template <typename Column> struct arrow_export_holder {
+    Column column;
+    const void* buffers[2];
+};
+
+} // namespace detail
+
+// Move a column into an Arrow C data interface array/schema pair without
+// copying its buffers. The consumer owns both structs and must call their
+// release callbacks; the column storage lives until the array is released.
+template <typename T, auto Pred>
+    requires detail::arrow_primitive<T>
+void export_arrow(RefinedColumn<T, Pred>&& column, ArrowArray* out_array,
+                  ArrowSchema* out_schema) {
+    using holder_t = detail::arrow_export_holder<RefinedColumn<T, Pred>>;
+
+    auto* holder = new holder_t{std::move(column), {nullptr, nullptr}};
+    const auto& col = holder->column;
+    holder->buffers[0] =
+        col.null_count() == 0 ? nullptr : col.validity_bitmap().data();
+    holder->buffers[1] = col.values().data();
+
+    *out_array = ArrowArray{
+        .length = static_cast<int64_t>(col.size()),
+        .null_count = static_cast<int64_t>(col.null_count()),
+        .offset = 0,
+        .n_buffers = 2,
+        .n_children = 0,
+        .buffers = holder->buffers,
+        .children = nullptr,
+        .dictionary = nullptr,
+        .release =
+            [](ArrowArray* array) {
+                delete static_cast<holder_t*>(array->private_data);
+                array->release = nullptr;
+            },
+        .private_data = holder,
+    };
+
+    *out_schema = ArrowSchema{
+        .format = detail::arrow_format<T>(),
+        .name = nullptr,
+        .metadata = nullptr,
+        .flags = ARROW_FLAG_NULLABLE,
+        .n_children = 0,
+        .children = nullptr,
+        .dictionary = nullptr,
+        .release = [](ArrowSchema* schema) { schema->release = nullptr; },
+        .private_data = nullptr,
+    };
+}
+
+} // namespace refinery
+
+#endif // REFINERY_COLUMN_HPP
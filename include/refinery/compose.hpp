@@ -6,10 +6,8 @@
 
 #include <concepts>
 #include <cstddef>
-#include <functional>
 #include <type_traits>
 #include <utility>
-#include <vector>
 
 namespace refinery {
 
@@ -71,56 +69,6 @@ inline constexpr auto AtMostN = [](const auto& v) constexpr {
     return count <= N;
 };
 
-// Runtime predicate composition (for dynamic predicates)
-namespace runtime {
-
-template <typename T> struct AllOf {
-    std::vector<std::function<bool(const T&)>> predicates;
-
-    template <typename... Preds>
-    explicit AllOf(Preds... preds) : predicates{preds...} {}
-
-    bool operator()(const T& v) const {
-        for (const auto& pred : predicates) {
-            if (!pred(v))
-                return false;
-        }
-        return true;
-    }
-};
-
-template <typename T> struct AnyOf {
-    std::vector<std::function<bool(const T&)>> predicates;
-
-    template <typename... Preds>
-    explicit AnyOf(Preds... preds) : predicates{preds...} {}
-
-    bool operator()(const T& v) const {
-        for (const auto& pred : predicates) {
-            if (pred(v))
-                return true;
-        }
-        return false;
-    }
-};
-
-template <typename T> struct NoneOf {
-    std::vector<std::function<bool(const T&)>> predicates;
-
-    template <typename... Preds>
-    explicit NoneOf(Preds... preds) : predicates{preds...} {}
-
-    bool operator()(const T& v) const {
-        for (const auto& pred : predicates) {
-            if (pred(v))
-                return false;
-        }
-        return true;
-    }
-};
-
-} // namespace runtime
-
 // Predicate on a member/projection
 // Apply<Proj, Pred> checks Pred(Proj(v))
 template <auto Projection, auto Pred>
@@ -132,6 +80,23 @@ template <auto MemPtr, auto Pred>
 inline constexpr auto OnMember =
     [](const auto& v) constexpr { return Pred(v.*MemPtr); };
 
+// Predicate on every element of a range
+// AllElements<Pred> checks Pred(e) for each e in v. Structural (like
+// Interval) so the element predicate can be recovered from the type.
+template <auto Pred> struct AllElementsOf {
+    static constexpr auto element_predicate = Pred;
+
+    constexpr bool operator()(const auto& v) const {
+        for (const auto& e : v) {
+            if (!Pred(e))
+                return false;
+        }
+        return true;
+    }
+};
+
+template <auto Pred> inline constexpr AllElementsOf<Pred> AllElements{};
+
 } // namespace refinery
 
 #endif // REFINERY_COMPOSE_HPP
@@ -0,0 +1,500 @@
+// core.hpp - Refined<T, Predicate>, construction tags and Interval
+// Part of the C++26 Refinement Types Library
+//
+// Everything most code needs, without <format>, <meta>, <functional> or
+// <vector>. Opt-in extras:
+//   diagnostics.hpp      reflection-based compile-time error messages
+//   format.hpp           std::formatter for Refined
+//   runtime_compose.hpp  runtime::AllOf/AnyOf/NoneOf
+// refinery.hpp includes all of them. Defining REFINERY_INVENTORY for the
+// whole program also pulls in inventory.hpp and records every construction
+// path each Refined type uses.
+
+#ifndef REFINERY_CORE_HPP
+#define REFINERY_CORE_HPP
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace refinery {
+
+// Concept to check if a predicate is valid for a type
+template <typename Pred, typename T>
+concept predicate_for = requires(Pred pred, T value) {
+    { pred(value) } -> std::convertible_to<bool>;
+};
+
+// Forward declaration so refinement_error can unwrap refined values
+template <typename T, auto Predicate>
+    requires predicate_for<decltype(Predicate), T>
+class Refined;
+
+namespace detail {
+
+template <typename T> struct is_refined_specialization : std::false_type {};
+
+template <typename T, auto Predicate>
+struct is_refined_specialization<Refined<T, Predicate>> : std::true_type {};
+
+// Textual form of any other type for a refinement_error message, found by
+// ADL. This fallback has none; format.hpp adds a better match that renders
+// std::formattable types with std::format.
+template <typename T> struct described {};
+
+template <typename T>
+std::optional<std::string> describe_other(described<T>, const T&, long) {
+    return std::nullopt;
+}
+
+// Render a value for a refinement_error message; nullopt if the type has
+// no textual form
+template <typename T>
+std::optional<std::string> describe_value(const T& value) {
+    if constexpr (std::same_as<T, bool>) {
+        return value ? "true" : "false";
+    } else if constexpr (std::same_as<T, char>) {
+        return std::string(1, value);
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        char buf[64];
+        auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+        if (ec != std::errc{}) {
+            return std::nullopt;
+        }
+        return std::string(buf, end);
+    } else if constexpr (std::convertible_to<const T&, std::string_view>) {
+        return std::string(std::string_view(value));
+    } else if constexpr (is_refined_specialization<T>::value) {
+        return describe_value(value.get());
+    } else {
+        return describe_other(described<T>{}, value, 0);
+    }
+}
+
+} // namespace detail
+
+// Exception for runtime refinement failures
+class refinement_error : public std::exception {
+  private:
+    std::string message_;
+
+  public:
+    template <typename T>
+    explicit refinement_error(const T& value,
+                              std::string_view pred_name = "predicate")
+        : message_("Refinement violation: ") {
+        message_ += detail::describe_value(value).value_or("value");
+        message_ += " does not satisfy ";
+        message_ += pred_name;
+    }
+
+    explicit refinement_error(std::string msg) : message_(std::move(msg)) {}
+
+    const char* what() const noexcept override { return message_.c_str(); }
+};
+
+// Tag type for runtime checking
+struct runtime_check_t {
+    explicit runtime_check_t() = default;
+};
+inline constexpr runtime_check_t runtime_check{};
+
+// Tag type for unchecked construction (use with caution)
+struct assume_valid_t {
+    explicit assume_valid_t() = default;
+};
+inline constexpr assume_valid_t assume_valid{};
+
+// How a Refined value was constructed (recorded by inventory.hpp)
+enum class construction : unsigned char {
+    compile_time,  // consteval constructor
+    runtime_check, // checked constructor, in_place, emplace or a checking
+                   // helper (try_refine, RefinedVector::push_back, ...)
+    assume_valid,  // unchecked constructor
+    implied,       // conversion from a refinement that implies this one
+};
+
+namespace detail {
+
+// Construction hook, a no-op unless REFINERY_INVENTORY is defined; count is
+// the number of values constructed or checked at once
+#ifdef REFINERY_INVENTORY
+template <typename R, construction Path>
+constexpr void note_construction(std::size_t count = 1) noexcept;
+#else
+template <typename R, construction Path>
+constexpr void note_construction(std::size_t = 1) noexcept {}
+#endif
+
+// Tag for adopting a value whose check the caller has already recorded with
+// note_construction, so the constructor records nothing
+struct adopt_checked_t {
+    explicit adopt_checked_t() = default;
+};
+inline constexpr adopt_checked_t adopt_checked{};
+
+} // namespace detail
+
+// Structural interval predicate: closed [Lo, Hi]
+// Valid as NTTP because it has no data members (bounds are template
+// parameters).
+template <auto Lo, auto Hi> struct Interval {
+    static constexpr auto lo = Lo;
+    static constexpr auto hi = Hi;
+
+    constexpr bool operator()(auto v) const { return v >= Lo && v <= Hi; }
+};
+
+// Trait to detect interval predicates
+namespace traits {
+
+template <typename T> struct interval_traits : std::false_type {};
+
+template <auto Lo, auto Hi>
+struct interval_traits<Interval<Lo, Hi>> : std::true_type {
+    static constexpr auto lo = Lo;
+    static constexpr auto hi = Hi;
+};
+
+} // namespace traits
+
+// Concept for interval predicates (takes an NTTP predicate value)
+template <auto Pred>
+concept interval_predicate = traits::interval_traits<decltype(Pred)>::value;
+
+// Detect interval-like predicates structurally (any type with lo/hi)
+namespace detail {
+
+template <auto Pred>
+concept has_interval_bounds = requires {
+    { decltype(Pred)::lo };
+    { decltype(Pred)::hi };
+};
+
+// Compile-time failure hook for Refined's consteval constructor, found by
+// ADL. This fallback is not constexpr, so reaching it ends constant
+// evaluation with the offending call in the diagnostic; diagnostics.hpp
+// adds a better match that throws a std::meta::exception naming the value.
+template <typename R> struct violation {};
+
+template <typename R, typename T>
+void predicate_not_satisfied(violation<R>, const T&, long) {}
+
+// INVOKE on a const value (std::invoke without <functional>)
+template <typename F, typename T>
+constexpr decltype(auto) invoke_on(F&& func, const T& value) {
+    if constexpr (std::is_member_function_pointer_v<std::decay_t<F>>) {
+        return (value.*func)();
+    } else if constexpr (std::is_member_object_pointer_v<std::decay_t<F>>) {
+        return (value.*func);
+    } else {
+        return std::forward<F>(func)(value);
+    }
+}
+
+} // namespace detail
+
+// Implication traits for predicate conversions (base template)
+namespace traits {
+
+template <auto SourcePred, auto TargetPred> struct implies {
+    static constexpr bool value = false;
+};
+
+} // namespace traits
+
+// Unified predicate implication check
+namespace detail {
+
+template <typename T, auto Source, auto Target>
+consteval bool predicate_implies() {
+    if constexpr (has_interval_bounds<Source> && has_interval_bounds<Target>) {
+        // Interval -> Interval: source must be a subset of target
+        return Source.lo >= Target.lo && Source.hi <= Target.hi;
+    } else {
+        // Predicate -> Predicate (including Interval -> Predicate):
+        // requires explicit traits::implies specialization.
+        return traits::implies<Source, Target>::value;
+    }
+}
+
+} // namespace detail
+
+// Core refinement type wrapper
+template <typename T, auto Predicate>
+    requires predicate_for<decltype(Predicate), T>
+class Refined {
+  public:
+    using value_type = T;
+    static constexpr auto predicate = Predicate;
+
+  private:
+    T value_;
+
+  public:
+    // Compile-time verified construction (consteval)
+    // This will fail at compile time if the predicate is not satisfied
+    consteval explicit Refined(T value) : value_(std::move(value)) {
+        detail::note_construction<Refined, construction::compile_time>();
+        if (!Predicate(value_)) {
+            // Not a constant expression; see detail::predicate_not_satisfied
+            predicate_not_satisfied(detail::violation<Refined>{}, value_, 0);
+        }
+    }
+
+    // Runtime checked construction
+    // Throws refinement_error if predicate is not satisfied
+    constexpr explicit Refined(T value, runtime_check_t)
+        : value_(std::move(value)) {
+        detail::note_construction<Refined, construction::runtime_check>();
+        if (!Predicate(value_)) {
+            throw refinement_error(value_);
+        }
+    }
+
+    // Unchecked construction (for trusted contexts)
+    // WARNING: Caller is responsible for ensuring predicate holds
+    constexpr explicit Refined(T value, assume_valid_t) noexcept
+        : value_(std::move(value)) {
+        detail::note_construction<Refined, construction::assume_valid>();
+    }
+
+    // Unchecked construction after a recorded check (library helpers)
+    constexpr Refined(T value, detail::adopt_checked_t) noexcept
+        : value_(std::move(value)) {}
+
+    // Runtime checked in-place construction from constructor arguments of T
+    // Throws refinement_error if predicate is not satisfied
+    template <typename... Args>
+        requires std::constructible_from<T, Args...>
+    constexpr explicit Refined(std::in_place_t, Args&&... args)
+        : value_(std::forward<Args>(args)...) {
+        detail::note_construction<Refined, construction::runtime_check>();
+        if (!Predicate(value_)) {
+            throw refinement_error(value_);
+        }
+    }
+
+    // Construct T in place, then validate (runtime checked, no extra move)
+    template <typename... Args>
+        requires std::constructible_from<T, Args...>
+    [[nodiscard]] static constexpr Refined emplace(Args&&... args) {
+        return Refined(std::in_place, std::forward<Args>(args)...);
+    }
+
+    // Default constructor only if T is default constructible AND default
+    // satisfies predicate
+    consteval Refined()
+        requires std::default_initializable<T>
+        : Refined(T{}) {}
+
+    // Copy and move constructors
+    constexpr Refined(const Refined&) = default;
+    constexpr Refined(Refined&&) = default;
+
+    // Copy and move assignment
+    constexpr Refined& operator=(const Refined&) = default;
+    constexpr Refined& operator=(Refined&&) = default;
+
+    // Implicit converting constructor from compatible refinements.
+    // Only participates in overload resolution when OtherPred provably
+    // implies Predicate (checked at compile time).
+    template <auto OtherPred>
+        requires(!std::same_as<decltype(OtherPred), decltype(Predicate)> ||
+                 OtherPred != Predicate) &&
+                predicate_for<decltype(OtherPred), T> &&
+                (detail::predicate_implies<T, OtherPred, Predicate>())
+    constexpr Refined(const Refined<T, OtherPred>& other) noexcept
+        : value_(other.get()) {
+        detail::note_construction<Refined, construction::implied>();
+    }
+
+    // Access the underlying value
+    [[nodiscard]] constexpr const T& get() const noexcept { return value_; }
+    [[nodiscard]] constexpr const T& operator*() const noexcept {
+        return value_;
+    }
+    [[nodiscard]] constexpr const T* operator->() const noexcept {
+        return &value_;
+    }
+
+    // Implicit conversion to const reference of underlying type
+    [[nodiscard]] constexpr operator const T&() const noexcept {
+        return value_;
+    }
+
+    // Explicit conversion to value (allows modification outside the wrapper)
+    [[nodiscard]] constexpr T release() && noexcept {
+        return std::move(value_);
+    }
+
+    // Check if a value would satisfy the predicate
+    [[nodiscard]] static constexpr bool is_valid(const T& value) noexcept {
+        return Predicate(value);
+    }
+
+    // Equality comparison
+    [[nodiscard]] friend constexpr bool operator==(const Refined& lhs,
+                                                   const Refined& rhs) {
+        return lhs.value_ == rhs.value_;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const Refined& lhs,
+                                                   const T& rhs) {
+        return lhs.value_ == rhs;
+    }
+
+    // Three-way comparison
+    [[nodiscard]] friend constexpr auto operator<=>(const Refined& lhs,
+                                                    const Refined& rhs)
+        requires std::three_way_comparable<T>
+    {
+        return lhs.value_ <=> rhs.value_;
+    }
+
+    [[nodiscard]] friend constexpr auto operator<=>(const Refined& lhs,
+                                                    const T& rhs)
+        requires std::three_way_comparable<T>
+    {
+        return lhs.value_ <=> rhs;
+    }
+};
+
+// Zero-overhead guarantee: Refined<T, Pred> must be the same size as T
+static_assert(sizeof(Refined<int, [](int v) { return v > 0; }>) == sizeof(int));
+static_assert(sizeof(Refined<double, [](double v) { return v > 0; }>) ==
+              sizeof(double));
+
+// Factory function for compile-time construction
+template <auto Predicate, typename T>
+    requires predicate_for<decltype(Predicate), T>
+[[nodiscard]] consteval auto make_refined(T value) {
+    return Refined<T, Predicate>(std::move(value));
+}
+
+// Factory function for runtime checked construction
+template <auto Predicate, typename T>
+    requires predicate_for<decltype(Predicate), T>
+[[nodiscard]] constexpr auto make_refined_checked(T value) {
+    return Refined<T, Predicate>(std::move(value), runtime_check);
+}
+
+namespace detail {
+
+// True if a V built from `T&&` and moved into a Refined cannot throw
+template <typename V, typename T>
+inline constexpr bool nothrow_adopt = std::is_nothrow_constructible_v<V, T> &&
+                                      std::is_nothrow_move_constructible_v<V>;
+
+} // namespace detail
+
+// Try to create a refined value, returning optional.
+// The value is checked before it is copied or moved, so a rejected rvalue
+// is left untouched for the caller. Copying an lvalue may throw.
+template <typename RefinedT, typename T = typename RefinedT::value_type>
+[[nodiscard]] constexpr std::optional<RefinedT> try_refine(T&& value) noexcept(
+    detail::nothrow_adopt<typename RefinedT::value_type, T&&>) {
+    detail::note_construction<RefinedT, construction::runtime_check>();
+    if (RefinedT::predicate(value)) {
+        return RefinedT(std::forward<T>(value), detail::adopt_checked);
+    }
+    return std::nullopt;
+}
+
+// Try to create a refined value with explicit predicate
+template <auto Predicate, typename T, typename U = std::remove_cvref_t<T>>
+    requires predicate_for<decltype(Predicate), U>
+[[nodiscard]] constexpr std::optional<Refined<U, Predicate>>
+try_refine(T&& value) noexcept(detail::nothrow_adopt<U, T&&>) {
+    detail::note_construction<Refined<U, Predicate>,
+                              construction::runtime_check>();
+    if (Predicate(value)) {
+        return Refined<U, Predicate>(std::forward<T>(value),
+                                     detail::adopt_checked);
+    }
+    return std::nullopt;
+}
+
+// Try to create a refined value, handing the rejected value back on failure
+template <typename RefinedT>
+[[nodiscard]] constexpr std::expected<RefinedT, typename RefinedT::value_type>
+try_refine_expected(typename RefinedT::value_type&& value) {
+    detail::note_construction<RefinedT, construction::runtime_check>();
+    if (RefinedT::predicate(value)) {
+        return std::expected<RefinedT, typename RefinedT::value_type>(
+            std::in_place, std::move(value), detail::adopt_checked);
+    }
+    return std::expected<RefinedT, typename RefinedT::value_type>(
+        std::unexpect, std::move(value));
+}
+
+// Assume a value is refined (unchecked, use with caution)
+template <auto Predicate, typename T>
+    requires predicate_for<decltype(Predicate), T>
+[[nodiscard]] constexpr auto assume_refined(T value) noexcept {
+    return Refined<T, Predicate>(std::move(value), assume_valid);
+}
+
+// Coerce from one refinement to another (runtime checked)
+template <typename ToRefined, typename FromRefined>
+    requires std::same_as<typename ToRefined::value_type,
+                          typename FromRefined::value_type>
+[[nodiscard]] constexpr ToRefined refine_to(const FromRefined& from) {
+    return ToRefined(from.get(), runtime_check);
+}
+
+// Try to coerce from one refinement to another
+template <typename ToRefined, typename FromRefined>
+    requires std::same_as<typename ToRefined::value_type,
+                          typename FromRefined::value_type>
+[[nodiscard]] constexpr std::optional<ToRefined>
+try_refine_to(const FromRefined& from) noexcept(
+    detail::nothrow_adopt<typename ToRefined::value_type,
+                          const typename FromRefined::value_type&>) {
+    return try_refine<ToRefined>(from.get());
+}
+
+// Transform a refined value, producing a new refined value
+template <auto NewPredicate, typename T, auto OldPredicate, typename F>
+    requires std::invocable<F, const T&> &&
+             predicate_for<decltype(NewPredicate),
+                           std::invoke_result_t<F, const T&>>
+[[nodiscard]] constexpr auto
+transform_refined(const Refined<T, OldPredicate>& refined, F&& func) {
+    using ResultT = std::invoke_result_t<F, const T&>;
+    return Refined<ResultT, NewPredicate>(
+        detail::invoke_on(std::forward<F>(func), refined.get()), runtime_check);
+}
+
+// Check if two refined types have the same predicate
+template <typename R1, typename R2>
+concept same_predicate = requires {
+    requires std::same_as<typename R1::value_type, typename R2::value_type>;
+    requires R1::predicate == R2::predicate;
+};
+
+// Concept for refined types
+template <typename T>
+concept is_refined = requires(typename T::value_type v) {
+    typename T::value_type;
+    { T::predicate(v) } -> std::convertible_to<bool>;
+};
+
+// Convenience alias
+template <typename T, auto Lo, auto Hi>
+using IntervalRefined = Refined<T, Interval<Lo, Hi>{}>;
+
+} // namespace refinery
+
+#ifdef REFINERY_INVENTORY
+#include "inventory.hpp"
+#endif
+
+#endif // REFINERY_CORE_HPP
@@ -0,0 +1,234 @@
+// counter.hpp - Sharded bounded counter for resource limiting
+// Part of the C++26 Refinement Types Library
+//
+// BoundedCounter<T, Lo, Hi> is a counting semaphore whose value always stays
+// in [Lo, Hi]: acquire(n) takes n units and release(n) returns them. Units
+// are spread over cache-line-padded shards, each an AtomicRefined, so threads
+// mostly touch their own shard. A thread whose shard runs dry steals from
+// the others and moves half of each victim's surplus home, which rebalances
+// the shards towards where units are being consumed.
+//
+// Units in use are sharded the same way. acquire takes units out of the
+// available pool before adding them to the in-use pool, and release does
+// the reverse, so neither can push the value outside [Lo, Hi]. A release
+// that its home shard cannot cover takes a mutex before gathering units
+// from the other shards; since only one thread moves in-use units between
+// shards at a time, none are in transit while it looks, and release fails
+// only on over-release.
+
+#ifndef REFINERY_COUNTER_HPP
+#define REFINERY_COUNTER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+
+#include "atomic.hpp"
+#include "core.hpp"
+#include "interval.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+// Stable per-thread value used to pick a home shard
+[[nodiscard]] inline std::size_t shard_hint() noexcept {
+    static thread_local const std::size_t hint =
+        std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return hint;
+}
+
+} // namespace detail
+
+template <typename T, T Lo, T Hi, std::size_t Shards = 16>
+    requires std::integral<T> && (Lo <= Hi) && (Shards > 0)
+class BoundedCounter {
+  public:
+    using value_type = T;
+    static constexpr T span = static_cast<T>(Hi - Lo);
+    static_assert(Lo + span == Hi, "Hi - Lo must be representable in T");
+
+    using refined_type = IntervalRefined<T, Lo, Hi>;
+    using amount_type = IntervalRefined<T, T{0}, span>;
+    static constexpr std::size_t shard_count = Shards;
+
+    explicit BoundedCounter(refined_type initial) noexcept {
+        distribute(available_, static_cast<T>(initial.get() - Lo));
+        distribute(in_use_, static_cast<T>(Hi - initial.get()));
+    }
+
+    BoundedCounter(const BoundedCounter&) = delete;
+    BoundedCounter& operator=(const BoundedCounter&) = delete;
+
+    // Take n units; returns false (taking nothing) if the value would drop
+    // below Lo. Like std::counting_semaphore::try_acquire, this may fail
+    // spuriously while other threads are moving units between shards.
+    [[nodiscard]] bool acquire(T n) {
+        if (!valid_amount(n)) {
+            return false;
+        }
+        if (n == 0) {
+            return true;
+        }
+        const std::size_t home = detail::shard_hint() % Shards;
+        const T got = take(available_, n, home);
+        if (got < n) {
+            put(available_, got, home);
+            return false;
+        }
+        put(in_use_, n, home);
+        return true;
+    }
+
+    // Return n units; returns false (returning nothing) only if fewer than n
+    // units are in use, i.e. more units are released than were acquired
+    [[nodiscard]] bool release(T n) {
+        if (!valid_amount(n)) {
+            return false;
+        }
+        if (n == 0) {
+            return true;
+        }
+        const std::size_t home = detail::shard_hint() % Shards;
+        const auto released = in_use_[home].units.try_update(
+            [n](T current) -> std::optional<T> {
+                if (current < n) {
+                    return std::nullopt;
+                }
+                return static_cast<T>(current - n);
+            },
+            std::memory_order_acq_rel);
+        if (!released && !release_slow(n, home)) {
+            return false;
+        }
+        put(available_, n, home);
+        return true;
+    }
+
+    // Current value. Exact when no acquire/release is in progress; otherwise
+    // a snapshot that may lag concurrent updates, but always in [Lo, Hi].
+    [[nodiscard]] refined_type value() const noexcept {
+        return refined_type(static_cast<T>(Lo + total(available_)),
+                            assume_valid);
+    }
+
+    // Units currently available to acquire (value() - Lo)
+    [[nodiscard]] amount_type available() const noexcept {
+        return amount_type(total(available_), assume_valid);
+    }
+
+    // Units currently acquired and not yet released (Hi - value())
+    [[nodiscard]] amount_type in_use() const noexcept {
+        return amount_type(total(in_use_), assume_valid);
+    }
+
+  private:
+    static constexpr auto shard_pred = Interval<T{0}, span>{};
+    using shard_atomic = AtomicRefined<T, shard_pred>;
+
+    struct alignas(detail::cache_line_size) shard {
+        shard_atomic units{amount_type(T{0}, assume_valid)};
+    };
+    using pool = std::array<shard, Shards>;
+
+    pool available_;
+    pool in_use_;
+    std::mutex rebalance_; // serializes release's slow path
+
+    static void distribute(pool& p, T amount) noexcept {
+        const auto total = static_cast<unsigned long long>(amount);
+        for (std::size_t i = 0; i < Shards; ++i) {
+            const auto part = total / Shards + (i < total % Shards ? 1 : 0);
+            p[i].units.store(amount_type(static_cast<T>(part), assume_valid),
+                             std::memory_order_relaxed);
+        }
+    }
+
+    static T total(const pool& p) noexcept {
+        T sum{0};
+        for (const auto& s : p) {
+            const T units = s.units.load(std::memory_order_acquire).get();
+            // Loads are not one snapshot, so clamp to the invariant
+            if (units >= span - sum) {
+                return span;
+            }
+            sum = static_cast<T>(sum + units);
+        }
+        return sum;
+    }
+
+    // Remove up to `want` units from p, starting at the home shard. Stealing
+    // from another shard also takes half of its surplus, which is deposited
+    // in the home shard. Returns the number of units obtained.
+    static T take(pool& p, T want, std::size_t home) {
+        T taken{0};
+        for (std::size_t k = 0; k < Shards && taken < want; ++k) {
+            const T need = static_cast<T>(want - taken);
+            const bool remote = k != 0;
+            T got{0};
+            (void)p[(home + k) % Shards].units.try_update(
+                [&](T current) -> std::optional<T> {
+                    got = current <= need || !remote
+                              ? std::min(current, need)
+                              : static_cast<T>(need + (current - need) / 2);
+                    if (got == 0) {
+                        return std::nullopt;
+                    }
+                    return static_cast<T>(current - got);
+                },
+                std::memory_order_acq_rel);
+            if (got > need) {
+                put(p, static_cast<T>(got - need), home);
+                got = need;
+            }
+            taken = static_cast<T>(taken + got);
+        }
+        return taken;
+    }
+
+    // Gather n in-use units from every shard. Other slow paths wait and
+    // fast-path updates are single atomic operations, so units are never in
+    // transit; but a concurrent acquire may add units to a shard already
+    // swept, so sweep again while a sweep finds any.
+    bool release_slow(T n, std::size_t home) {
+        const std::lock_guard lock(rebalance_);
+        T got{0};
+        for (;;) {
+            const T more = take(in_use_, static_cast<T>(n - got), home);
+            got = static_cast<T>(got + more);
+            if (got == n) {
+                return true;
+            }
+            if (more == 0) {
+                put(in_use_, got, home);
+                return false;
+            }
+        }
+    }
+
+    static void put(pool& p, T n, std::size_t home) {
+        if (n != 0) {
+            (void)p[home].units.fetch_add(n, std::memory_order_acq_rel);
+        }
+    }
+
+    static constexpr bool valid_amount(T n) noexcept {
+        if constexpr (std::is_signed_v<T>) {
+            if (n < 0) {
+                return false;
+            }
+        }
+        return n <= span;
+    }
+};
+
+} // namespace refinery
+
+#endif // REFINERY_COUNTER_HPP
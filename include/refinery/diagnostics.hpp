@@ -1,17 +1,21 @@
 // diagnostics.hpp - Error formatting via reflection
 // Part of the C++26 Refinement Types Library
+//
+// Opt-in: with this header included, a failed compile-time construction of
+// Refined reports the offending value through std::meta::exception instead
+// of a plain "call to non-constexpr function" error. Include it before the
+// first such construction in a translation unit.
 
 #ifndef REFINERY_DIAGNOSTICS_HPP
 #define REFINERY_DIAGNOSTICS_HPP
 
-#include <exception>
 #include <format>
-#include <source_location>
 #include <string>
-#include <string_view>
 
 #include <meta>
 
+#include "core.hpp"
+
 namespace refinery {
 
 namespace detail {
@@ -30,44 +34,19 @@ consteval std::string build_violation_message(const T& value) {
                        format_value(value));
 }
 
-} // namespace detail
-
-// Exception for runtime refinement failures
-class refinement_error : public std::exception {
-  private:
-    std::string message_;
-
-  public:
-    template <typename T>
-        requires std::formattable<T, char>
-    explicit refinement_error(const T& value,
-                              std::string_view pred_name = "predicate")
-        : message_(std::format("Refinement violation: {} does not satisfy {}",
-                               value, pred_name)) {}
-
-    template <typename T>
-        requires(!std::formattable<T, char>)
-    explicit refinement_error(const T&,
-                              std::string_view pred_name = "predicate")
-        : message_(std::format(
-              "Refinement violation: value does not satisfy {}", pred_name)) {}
-
-    explicit refinement_error(std::string msg) : message_(std::move(msg)) {}
-
-    const char* what() const noexcept override { return message_.c_str(); }
-};
+// Preferred over the core fallback (int vs long); R is the Refined type
+template <typename R, typename T>
+consteval void predicate_not_satisfied(violation<R>, const T& value, int) {
+    throw std::meta::exception(build_violation_message(value), ^^R);
+}
 
-// Tag type for runtime checking
-struct runtime_check_t {
-    explicit runtime_check_t() = default;
-};
-inline constexpr runtime_check_t runtime_check{};
+} // namespace detail
 
-// Tag type for unchecked construction (use with caution)
-struct assume_valid_t {
-    explicit assume_valid_t() = default;
-};
-inline constexpr assume_valid_t assume_valid{};
+// Get reflection info for the Refined type itself
+template <typename T, auto Predicate>
+consteval std::meta::info type_info(const Refined<T, Predicate>&) {
+    return ^^Refined<T, Predicate>;
+}
 
 } // namespace refinery
 
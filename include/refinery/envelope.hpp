@@ -0,0 +1,463 @@
+// envelope.hpp - Serialized bulk refined data that keeps its refinement
+// Part of the C++26 Refinement Types Library
+//
+// seal() writes a span of Refined<T, Pred> into a byte buffer (a socket
+// payload, a shared-memory segment, a file) behind an envelope_header that
+// records a fingerprint of the Refined<T, Pred> type and a checksum of the
+// payload. open_envelope<T, Pred>() on the receiving side verifies the header
+// and the checksum -- one linear hash -- and adopts the payload in place as
+// span<const Refined<T, Pred>> without evaluating the predicate again.
+//
+// The fingerprint is derived at compile time from the reflected name of T,
+// the predicate's identity -- its traits::envelope_tag for closures, its
+// reflected name otherwise -- the values of its data members (captures),
+// the element size and alignment, and the byte order. It holds no paths or
+// source locations, so it is stable across checkouts; both sides must be
+// built with the same predicate definitions. The checksum detects corruption
+// and type mix-ups; it is not a MAC and does not make the data trustworthy if
+// the sender is not.
+
+#ifndef REFINERY_ENVELOPE_HPP
+#define REFINERY_ENVELOPE_HPP
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <meta>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "core.hpp"
+#include "predicates.hpp"
+#include "vector.hpp"
+
+namespace refinery {
+
+// Fixed-size prefix of every envelope, followed directly by the payload
+struct envelope_header {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t element_size;
+    std::uint64_t fingerprint;
+    std::uint64_t count;
+    std::uint64_t checksum;
+};
+
+static_assert(sizeof(envelope_header) == 32 &&
+              std::is_trivially_copyable_v<envelope_header>);
+
+inline constexpr std::uint32_t envelope_magic = 0x454E4652; // "RFNE"
+inline constexpr std::uint16_t envelope_version = 3;
+
+namespace traits {
+
+// envelope_tag<PredT>::value names a closure predicate type the same way in
+// every build. Closure types have no portable name, and stateless ones such
+// as Positive and Not<Negative> differ only in their bodies, so a closure
+// needs a tag to be sealed; its captures are fingerprinted through
+// reflection. Named predicate types use their reflected name instead.
+template <typename PredT> struct envelope_tag {};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(Positive)>> {
+    static constexpr std::string_view value = "refinery::Positive";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(Negative)>> {
+    static constexpr std::string_view value = "refinery::Negative";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(Zero)>> {
+    static constexpr std::string_view value = "refinery::Zero";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(NonNegative)>> {
+    static constexpr std::string_view value = "refinery::NonNegative";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(NonPositive)>> {
+    static constexpr std::string_view value = "refinery::NonPositive";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(NonZero)>> {
+    static constexpr std::string_view value = "refinery::NonZero";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(Empty)>> {
+    static constexpr std::string_view value = "refinery::Empty";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(NonEmpty)>> {
+    static constexpr std::string_view value = "refinery::NonEmpty";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(Sorted)>> {
+    static constexpr std::string_view value = "refinery::Sorted";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(IsNull)>> {
+    static constexpr std::string_view value = "refinery::IsNull";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(NotNull)>> {
+    static constexpr std::string_view value = "refinery::NotNull";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(Even)>> {
+    static constexpr std::string_view value = "refinery::Even";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(Odd)>> {
+    static constexpr std::string_view value = "refinery::Odd";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(PowerOfTwo)>> {
+    static constexpr std::string_view value = "refinery::PowerOfTwo";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(Finite)>> {
+    static constexpr std::string_view value = "refinery::Finite";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(Normalized)>> {
+    static constexpr std::string_view value = "refinery::Normalized";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(IsNaN)>> {
+    static constexpr std::string_view value = "refinery::IsNaN";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(NotNaN)>> {
+    static constexpr std::string_view value = "refinery::NotNaN";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(IsInf)>> {
+    static constexpr std::string_view value = "refinery::IsInf";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(IsNormal)>> {
+    static constexpr std::string_view value = "refinery::IsNormal";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(Always)>> {
+    static constexpr std::string_view value = "refinery::Always";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(Never)>> {
+    static constexpr std::string_view value = "refinery::Never";
+};
+
+// Factories, for the common int bounds; other bound types need their own
+template <> struct envelope_tag<std::remove_cv_t<decltype(GreaterThan(0))>> {
+    static constexpr std::string_view value = "refinery::GreaterThan(int)";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(GreaterOrEqual(0))>> {
+    static constexpr std::string_view value = "refinery::GreaterOrEqual(int)";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(LessThan(0))>> {
+    static constexpr std::string_view value = "refinery::LessThan(int)";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(LessOrEqual(0))>> {
+    static constexpr std::string_view value = "refinery::LessOrEqual(int)";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(EqualTo(0))>> {
+    static constexpr std::string_view value = "refinery::EqualTo(int)";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(NotEqualTo(0))>> {
+    static constexpr std::string_view value = "refinery::NotEqualTo(int)";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(InRange(0, 0))>> {
+    static constexpr std::string_view value = "refinery::InRange(int, int)";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(InOpenRange(0, 0))>> {
+    static constexpr std::string_view value = "refinery::InOpenRange(int, int)";
+};
+
+template <>
+struct envelope_tag<std::remove_cv_t<decltype(InHalfOpenRange(0, 0))>> {
+    static constexpr std::string_view value = "refinery::InHalfOpenRange(int, int)";
+};
+
+template <> struct envelope_tag<std::remove_cv_t<decltype(DivisibleBy(0))>> {
+    static constexpr std::string_view value = "refinery::DivisibleBy(int)";
+};
+
+} // namespace traits
+
+namespace detail {
+
+inline constexpr std::uint64_t hash_p1 = 0x9E3779B185EBCA87ULL;
+inline constexpr std::uint64_t hash_p2 = 0xC2B2AE3D27D4EB4FULL;
+inline constexpr std::uint64_t hash_p3 = 0x165667B19E3779F9ULL;
+inline constexpr std::uint64_t hash_p4 = 0x85EBCA77C2B2AE63ULL;
+inline constexpr std::uint64_t hash_p5 = 0x27D4EB2F165667C5ULL;
+
+constexpr std::uint64_t fnv1a(std::string_view text,
+                              std::uint64_t h = 0xCBF29CE484222325ULL) {
+    for (char c : text) {
+        h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3ULL;
+    }
+    return h;
+}
+
+// Closure predicates have no portable name, so they are identified by their
+// traits::envelope_tag; named class types (Interval<0, 100>) and functions
+// by their reflected name
+template <typename PredT>
+concept tagged_predicate = requires {
+    {
+        traits::envelope_tag<PredT>::value
+    } -> std::convertible_to<std::string_view>;
+};
+
+template <typename PredT> consteval bool stable_identity() {
+    return !std::is_class_v<PredT> || tagged_predicate<PredT> ||
+           std::meta::has_identifier(^^PredT) ||
+           std::meta::has_template_arguments(^^PredT);
+}
+
+template <typename PredT> consteval std::size_t state_member_count() {
+    return std::meta::nonstatic_data_members_of(
+               ^^PredT, std::meta::access_context::unchecked())
+        .size();
+}
+
+// Mixes in the value of every data member of Pred (its captures, for a
+// closure), so InRange(0, 500) and InRange(0, 600) differ
+template <auto Pred> consteval std::uint64_t state_of(std::uint64_t h) {
+    using PredT = std::remove_cv_t<decltype(Pred)>;
+    template for (constexpr auto member :
+                  std::define_static_array(std::meta::nonstatic_data_members_of(
+                      ^^PredT, std::meta::access_context::unchecked()))) {
+        h = fnv1a(std::meta::display_string_of(
+                      std::meta::reflect_constant(Pred.[:member:])),
+                  fnv1a(std::string_view("|"), h));
+    }
+    return h;
+}
+
+template <typename T, auto Pred> consteval std::uint64_t fingerprint_of() {
+    using PredT = std::remove_cv_t<decltype(Pred)>;
+    static_assert(stable_identity<PredT>(),
+                  "closure predicates need a traits::envelope_tag "
+                  "specialization to be sealed");
+    static_assert(std::is_empty_v<PredT> || state_member_count<PredT>() > 0,
+                  "the predicate's state is not visible to reflection");
+    std::uint64_t h = fnv1a(std::meta::display_string_of(^^T));
+    if constexpr (tagged_predicate<PredT>) {
+        h = fnv1a(std::string_view(traits::envelope_tag<PredT>::value),
+                  fnv1a(std::string_view("|tag|"), h));
+    } else {
+        h = fnv1a(
+            std::meta::display_string_of(std::meta::reflect_constant(Pred)),
+            fnv1a(std::string_view("|"), h));
+    }
+    if constexpr (std::is_class_v<PredT>) {
+        h = state_of<Pred>(h);
+    }
+    h = fnv1a(std::string_view("|"), h) ^ sizeof(T);
+    h = (h * hash_p1) ^ alignof(T);
+    h = (h * hash_p1) ^ (std::endian::native == std::endian::little ? 1 : 2);
+    return h * hash_p1;
+}
+
+[[nodiscard]] inline std::uint64_t load_u64(const std::byte* p) noexcept {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+[[nodiscard]] constexpr std::uint64_t hash_round(std::uint64_t acc,
+                                                 std::uint64_t lane) noexcept {
+    return std::rotl(acc + lane * hash_p2, 31) * hash_p1;
+}
+
+// 64-bit multiply-rotate hash in the style of xxHash64 (not wire
+// compatible). Four independent lanes over 32-byte stripes keep several
+// multiplies in flight, so large payloads hash at several bytes per cycle.
+[[nodiscard]] inline std::uint64_t checksum(std::span<const std::byte> bytes,
+                                            std::uint64_t seed) noexcept {
+    const std::byte* p = bytes.data();
+    std::size_t n = bytes.size();
+    std::uint64_t h;
+    if (n >= 32) {
+        std::uint64_t acc[4] = {seed + hash_p1 + hash_p2, seed + hash_p2,
+                                seed, seed - hash_p1};
+        for (; n >= 32; p += 32, n -= 32) {
+            for (std::size_t k = 0; k < 4; ++k) {
+                acc[k] = hash_round(acc[k], load_u64(p + 8 * k));
+            }
+        }
+        h = std::rotl(acc[0], 1) + std::rotl(acc[1], 7) +
+            std::rotl(acc[2], 12) + std::rotl(acc[3], 18);
+        for (std::uint64_t a : acc) {
+            h = (h ^ hash_round(0, a)) * hash_p1 + hash_p4;
+        }
+    } else {
+        h = seed + hash_p5;
+    }
+    h += bytes.size();
+    for (; n >= 8; p += 8, n -= 8) {
+        h ^= hash_round(0, load_u64(p));
+        h = std::rotl(h, 27) * hash_p1 + hash_p4;
+    }
+    for (; n > 0; ++p, --n) {
+        h ^= std::to_integer<std::uint64_t>(*p) * hash_p5;
+        h = std::rotl(h, 11) * hash_p1;
+    }
+    h ^= h >> 33;
+    h *= hash_p2;
+    h ^= h >> 29;
+    h *= hash_p3;
+    h ^= h >> 32;
+    return h;
+}
+
+// The payload holds the bytes of the Refined<T, Pred> elements, right after
+// the header. Being trivially copyable, the elements are implicit-lifetime,
+// so open_envelope can start their lifetime over the received bytes.
+template <typename T, auto Pred>
+concept sealable = std::is_trivially_copyable_v<T> &&
+                   std::is_trivially_copyable_v<Refined<T, Pred>> &&
+                   sizeof(Refined<T, Pred>) == sizeof(T) &&
+                   alignof(Refined<T, Pred>) == alignof(T) &&
+                   sizeof(envelope_header) % alignof(T) == 0 &&
+                   sizeof(T) <= 0xFFFF;
+
+// Reason the envelope cannot be adopted, or nullptr if it can
+template <typename T, auto Pred>
+[[nodiscard]] const char* envelope_defect(std::span<const std::byte> buffer,
+                                          envelope_header& header) noexcept {
+    if (buffer.size() < sizeof(envelope_header)) {
+        return "buffer smaller than envelope header";
+    }
+    std::memcpy(&header, buffer.data(), sizeof(header));
+    if (header.magic != envelope_magic ||
+        header.version != envelope_version) {
+        return "not a refinery envelope";
+    }
+    if (header.fingerprint != fingerprint_of<T, Pred>() ||
+        header.element_size != sizeof(T)) {
+        return "envelope holds a different refined type";
+    }
+    const std::size_t room = buffer.size() - sizeof(envelope_header);
+    if (header.count > room / sizeof(T)) {
+        return "envelope payload truncated";
+    }
+    const std::byte* payload = buffer.data() + sizeof(envelope_header);
+    if (reinterpret_cast<std::uintptr_t>(payload) % alignof(T) != 0) {
+        return "envelope payload misaligned";
+    }
+    const std::span<const std::byte> bytes(payload, header.count * sizeof(T));
+    if (checksum(bytes, header.fingerprint) != header.checksum) {
+        return "envelope checksum mismatch";
+    }
+    return nullptr;
+}
+
+} // namespace detail
+
+// Compile-time fingerprint identifying Refined<T, Pred> in an envelope
+template <typename T, auto Pred>
+inline constexpr std::uint64_t predicate_fingerprint =
+    detail::fingerprint_of<T, Pred>();
+
+// Bytes needed to seal `count` elements of T
+template <typename T>
+[[nodiscard]] constexpr std::size_t envelope_size(std::size_t count) noexcept {
+    return sizeof(envelope_header) + count * sizeof(T);
+}
+
+// Write header and payload into `out`; returns the number of bytes written
+// Throws std::length_error if out is smaller than envelope_size<T>(n)
+template <typename T, auto Pred>
+    requires detail::sealable<T, Pred>
+std::size_t seal_into(std::span<const Refined<T, Pred>> values,
+                      std::span<std::byte> out) {
+    const std::size_t size = envelope_size<T>(values.size());
+    if (out.size() < size) {
+        throw std::length_error("seal_into: buffer too small");
+    }
+    const auto payload = std::as_bytes(values);
+    const envelope_header header{
+        envelope_magic,
+        envelope_version,
+        static_cast<std::uint16_t>(sizeof(T)),
+        predicate_fingerprint<T, Pred>,
+        values.size(),
+        detail::checksum(payload, predicate_fingerprint<T, Pred>),
+    };
+    std::memcpy(out.data(), &header, sizeof(header));
+    if (!payload.empty()) {
+        std::memcpy(out.data() + sizeof(header), payload.data(),
+                    payload.size());
+    }
+    return size;
+}
+
+template <typename T, auto Pred>
+    requires detail::sealable<T, Pred>
+[[nodiscard]] std::vector<std::byte>
+seal(std::span<const Refined<T, Pred>> values) {
+    std::vector<std::byte> out(envelope_size<T>(values.size()));
+    seal_into(values, std::span<std::byte>(out));
+    return out;
+}
+
+template <typename T, auto Pred, typename Allocator>
+    requires detail::sealable<T, Pred>
+[[nodiscard]] std::vector<std::byte>
+seal(const RefinedVector<T, Pred, Allocator>& values) {
+    return seal(values.refined());
+}
+
+// Adopt a sealed buffer as refined elements, verifying only the header and
+// the checksum. The span aliases `buffer`, which must stay alive and
+// unmodified while it is used.
+// Throws refinement_error describing the defect if the envelope is rejected
+template <typename T, auto Pred>
+    requires detail::sealable<T, Pred>
+[[nodiscard]] std::span<const Refined<T, Pred>>
+open_envelope(std::span<const std::byte> buffer) {
+    envelope_header header;
+    if (const char* defect = detail::envelope_defect<T, Pred>(buffer, header)) {
+        throw refinement_error(std::string("open_envelope: ") + defect);
+    }
+    const auto count = static_cast<std::size_t>(header.count);
+    return {std::start_lifetime_as_array<const Refined<T, Pred>>(
+                buffer.data() + sizeof(envelope_header), count),
+            count};
+}
+
+template <typename T, auto Pred>
+    requires detail::sealable<T, Pred>
+[[nodiscard]] std::optional<std::span<const Refined<T, Pred>>>
+try_open_envelope(std::span<const std::byte> buffer) noexcept {
+    envelope_header header;
+    if (detail::envelope_defect<T, Pred>(buffer, header) != nullptr) {
+        return std::nullopt;
+    }
+    const auto count = static_cast<std::size_t>(header.count);
+    return std::span<const Refined<T, Pred>>(
+        std::start_lifetime_as_array<const Refined<T, Pred>>(
+            buffer.data() + sizeof(envelope_header), count),
+        count);
+}
+
+} // namespace refinery
+
+#endif // REFINERY_ENVELOPE_HPP
@@ -0,0 +1,190 @@
+// epoch.hpp - Epoch-based reclamation for read-mostly shared data
+// Part of the C++26 Refinement Types Library
+//
+// Readers pin the current epoch for the duration of a read (two stores and a
+// fence, no loops, no locks). Writers retire objects they have unlinked;
+// a retired object is freed once the global epoch has advanced twice past
+// the epoch it was retired in, which implies every reader that could still
+// see it has unpinned. Writers serialize on a mutex, readers never block.
+//
+// There is a single process-wide domain, epoch_domain::global(), so each
+// thread needs exactly one announcement record.
+
+#ifndef REFINERY_EPOCH_HPP
+#define REFINERY_EPOCH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "atomic.hpp"
+
+namespace refinery {
+
+class epoch_domain {
+  public:
+    // Per-thread announcement slot. Records are never freed (a thread may
+    // outlive the domain during static destruction); a record is reused by
+    // another thread after its owner exits.
+    struct alignas(detail::cache_line_size) record {
+        std::atomic<std::uint64_t> epoch{0}; // 0 = not pinned
+        std::atomic<bool> in_use{false};
+        record* next = nullptr;
+        unsigned depth = 0; // nesting level, owner thread only
+    };
+
+    // RAII pin of the current epoch. Nested guards on one thread are allowed.
+    // The first pin on a thread may allocate its record, and throws
+    // std::bad_alloc if that fails; later pins do not allocate.
+    class guard {
+      public:
+        explicit guard(epoch_domain& domain)
+            : record_(domain.local_record()) {
+            if (record_->depth++ == 0) {
+                record_->epoch.store(
+                    domain.epoch_.load(std::memory_order_acquire),
+                    std::memory_order_relaxed);
+                // Publish the pin before any shared pointer is read
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+
+        guard(const guard&) = delete;
+        guard& operator=(const guard&) = delete;
+
+        ~guard() {
+            if (--record_->depth == 0) {
+                record_->epoch.store(0, std::memory_order_release);
+            }
+        }
+
+      private:
+        record* record_;
+    };
+
+    epoch_domain(const epoch_domain&) = delete;
+    epoch_domain& operator=(const epoch_domain&) = delete;
+
+    // Frees whatever is still retired; no reader may be pinned
+    ~epoch_domain() {
+        for (const auto& r : retired_) {
+            r.deleter(r.object);
+        }
+    }
+
+    [[nodiscard]] static epoch_domain& global() {
+        static epoch_domain domain;
+        return domain;
+    }
+
+    [[nodiscard]] guard pin() { return guard(*this); }
+
+    // Hand over an unlinked object; it is destroyed with deleter(object)
+    // once no reader can hold a reference to it
+    void retire(void* object, void (*deleter)(void*)) {
+        std::lock_guard lock(mutex_);
+        retired_.push_back(
+            {object, deleter, epoch_.load(std::memory_order_relaxed)});
+        collect_locked();
+    }
+
+    template <typename T> void retire(const T* object) {
+        retire(const_cast<T*>(object),
+               [](void* p) { delete static_cast<T*>(p); });
+    }
+
+    // Try to advance the epoch and free eligible objects; never blocks on
+    // readers. Returns the number of objects still waiting.
+    std::size_t collect() {
+        std::lock_guard lock(mutex_);
+        collect_locked();
+        return retired_.size();
+    }
+
+    // Free every object retired so far, waiting for pinned readers to
+    // leave. Must not be called while this thread is pinned.
+    void synchronize() {
+        while (collect() != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+  private:
+    epoch_domain() = default;
+
+    struct retired_object {
+        void* object;
+        void (*deleter)(void*);
+        std::uint64_t epoch;
+    };
+
+    // The epoch can advance once every pinned reader has observed it
+    bool try_advance() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::uint64_t current = epoch_.load(std::memory_order_relaxed);
+        for (record* r = records_.load(std::memory_order_acquire);
+             r != nullptr; r = r->next) {
+            const std::uint64_t e = r->epoch.load(std::memory_order_acquire);
+            if (e != 0 && e != current) {
+                return false;
+            }
+        }
+        epoch_.store(current + 1, std::memory_order_release);
+        return true;
+    }
+
+    void collect_locked() {
+        try_advance();
+        const std::uint64_t current = epoch_.load(std::memory_order_relaxed);
+        std::erase_if(retired_, [current](const retired_object& r) {
+            if (r.epoch + 2 > current) {
+                return false;
+            }
+            r.deleter(r.object);
+            return true;
+        });
+    }
+
+    // Claim a free record or append a new one (lock-free)
+    record* acquire_record() {
+        for (record* r = records_.load(std::memory_order_acquire);
+             r != nullptr; r = r->next) {
+            bool expected = false;
+            if (!r->in_use.load(std::memory_order_relaxed) &&
+                r->in_use.compare_exchange_strong(expected, true)) {
+                return r;
+            }
+        }
+        auto* r = new record;
+        r->in_use.store(true, std::memory_order_relaxed);
+        r->next = records_.load(std::memory_order_relaxed);
+        while (!records_.compare_exchange_weak(r->next, r,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+        }
+        return r;
+    }
+
+    // This thread's record, claimed on first use and handed back when the
+    // thread exits
+    record* local_record() {
+        struct holder {
+            record* rec;
+            ~holder() { rec->in_use.store(false, std::memory_order_release); }
+        };
+        thread_local holder local{acquire_record()};
+        return local.rec;
+    }
+
+    std::atomic<std::uint64_t> epoch_{1};
+    std::atomic<record*> records_{nullptr};
+    std::mutex mutex_;
+    std::vector<retired_object> retired_;
+};
+
+} // namespace refinery
+
+#endif // REFINERY_EPOCH_HPP
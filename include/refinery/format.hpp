@@ -0,0 +1,36 @@
+// format.hpp - std::format support for refined values
+// Part of the C++26 Refinement Types Library
+
+#ifndef REFINERY_FORMAT_HPP
+#define REFINERY_FORMAT_HPP
+
+#include <format>
+
+#include <optional>
+#include <string>
+
+#include "core.hpp"
+
+namespace refinery::detail {
+
+// refinement_error messages for types without a built-in textual form; see
+// detail::describe_other
+template <typename T>
+    requires std::formattable<T, char>
+std::optional<std::string> describe_other(described<T>, const T& value, int) {
+    return std::format("{}", value);
+}
+
+} // namespace refinery::detail
+
+// Formatter specialization for Refined types
+template <typename T, auto Pred>
+struct std::formatter<refinery::Refined<T, Pred>> : std::formatter<T> {
+    template <typename FormatContext>
+    auto format(const refinery::Refined<T, Pred>& val,
+                FormatContext& ctx) const {
+        return std::formatter<T>::format(val.get(), ctx);
+    }
+};
+
+#endif // REFINERY_FORMAT_HPP
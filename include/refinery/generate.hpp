@@ -0,0 +1,601 @@
+// generate.hpp - Random values for refined types (test and load data)
+// Part of the C++26 Refinement Types Library
+//
+// generate<R>(rng, out) fills `out` with random values satisfying
+// R::predicate. How a value is drawn depends on what is known about the
+// predicate:
+//   - Interval (any predicate with lo/hi): uniform over [lo, hi], one draw
+//   - predicates with a traits::sampler (Positive, NonZero, Even, ...):
+//     constructed from one draw
+//   - anything else (opaque lambdas, compositions): rejection sampling over
+//     the whole range of T, 64 candidates at a time, checked with a
+//     branch-free loop and handed out through the resulting bit mask
+// generate_options::invalid_fraction makes that share of the output violate
+// the predicate, at random positions, for exercising validation paths.
+//
+//   std::mt19937_64 rng(42);
+//   std::vector<int> ports(1'000'000);
+//   generate<IntervalRefined<int, 1, 65535>>(rng, ports,
+//                                            {.invalid_fraction = 0.01});
+
+#ifndef REFINERY_GENERATE_HPP
+#define REFINERY_GENERATE_HPP
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "bulk.hpp"
+#include "core.hpp"
+#include "predicates.hpp"
+
+namespace refinery {
+
+namespace traits {
+template <typename PredT> struct sampler;
+} // namespace traits
+
+struct generate_options {
+    // Share of the output that violates the predicate, in [0, 1]; the count
+    // is rounded to the nearest integer
+    double invalid_fraction = 0.0;
+    // Consecutive rejected candidates after which rejection sampling gives
+    // up with refinement_error (the predicate is too selective for it)
+    std::size_t max_rejections = std::size_t{1} << 20;
+};
+
+namespace detail {
+
+// Uniform integer in [lo, hi] (also for bool and char-sized types, which
+// uniform_int_distribution does not accept)
+template <std::integral T, typename Rng> T uniform_in(Rng& rng, T lo, T hi) {
+    using W = std::conditional_t<std::is_signed_v<T>, long long,
+                                 unsigned long long>;
+    return static_cast<T>(std::uniform_int_distribution<W>(lo, hi)(rng));
+}
+
+// Uniform floating-point value in [lo, hi]
+template <std::floating_point T, typename Rng>
+T uniform_in(Rng& rng, T lo, T hi) {
+    if (!(lo < hi)) {
+        return lo;
+    }
+    if (std::isfinite(hi - lo)) {
+        return std::uniform_real_distribution<T>(lo, hi)(rng);
+    }
+    // hi - lo overflows: sample the halved range and scale back
+    return std::uniform_real_distribution<T>(lo / 2, hi / 2)(rng) * 2;
+}
+
+// Uniform value outside [lo, hi], below or above with equal probability
+// when both sides exist. For floating point the infinities lie outside
+// [lowest, max], but only count when `rejects` holds for them (a range
+// such as [0, max] may stand for a predicate that accepts +inf).
+template <typename T, typename Rng, typename Rejects>
+T uniform_outside(Rng& rng, T lo, T hi, Rejects rejects) {
+    using limits = std::numeric_limits<T>;
+    bool below = lo > limits::lowest();
+    bool above = hi < limits::max();
+    if constexpr (std::floating_point<T>) {
+        below = below || (lo > -limits::infinity() &&
+                          static_cast<bool>(rejects(-limits::infinity())));
+        above = above || (hi < limits::infinity() &&
+                          static_cast<bool>(rejects(limits::infinity())));
+    }
+    if (!below && !above) {
+        throw refinement_error(
+            std::string("generate: every value of the type satisfies the "
+                        "predicate"));
+    }
+    if (below && (!above || uniform_in(rng, 0, 1) == 0)) {
+        if constexpr (std::floating_point<T>) {
+            if (lo == limits::lowest()) {
+                return -limits::infinity();
+            }
+            return uniform_in(rng, limits::lowest(),
+                              std::nextafter(lo, -limits::infinity()));
+        } else {
+            return uniform_in(rng, limits::lowest(), static_cast<T>(lo - 1));
+        }
+    }
+    if constexpr (std::floating_point<T>) {
+        if (hi == limits::max()) {
+            return limits::infinity();
+        }
+        return uniform_in(rng, std::nextafter(hi, limits::infinity()),
+                          limits::max());
+    } else {
+        return uniform_in(rng, static_cast<T>(hi + 1), limits::max());
+    }
+}
+
+// Any finite value of T: uniform for integers, uniform over bit patterns
+// for float/double (so every magnitude is represented)
+template <typename T, typename Rng> T draw_any(Rng& rng) {
+    using limits = std::numeric_limits<T>;
+    if constexpr (std::integral<T>) {
+        return uniform_in(rng, limits::lowest(), limits::max());
+    } else if constexpr (limits::is_iec559 &&
+                         (sizeof(T) == 4 || sizeof(T) == 8)) {
+        using Bits =
+            std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+        std::uniform_int_distribution<Bits> bits;
+        T v;
+        do {
+            v = std::bit_cast<T>(bits(rng));
+        } while (!std::isfinite(v));
+        return v;
+    } else {
+        return uniform_in(rng, limits::lowest(), limits::max());
+    }
+}
+
+// Fill `out` with draw_any values; when the generator yields full-width
+// words, each word is split into several candidates of a narrower T
+template <typename T, typename Rng, std::size_t N>
+void fill_any(Rng& rng, std::array<T, N>& out) {
+    using Word = typename Rng::result_type;
+    constexpr bool full_words =
+        Rng::min() == 0 && Rng::max() == std::numeric_limits<Word>::max();
+    constexpr bool raw_bits =
+        (std::integral<T> && !std::same_as<T, bool>) ||
+        (std::numeric_limits<T>::is_iec559 &&
+         (sizeof(T) == 4 || sizeof(T) == 8));
+    if constexpr (full_words && raw_bits && sizeof(Word) % sizeof(T) == 0 &&
+                  sizeof(out) % sizeof(Word) == 0) {
+        std::array<Word, sizeof(out) / sizeof(Word)> words;
+        for (auto& w : words) {
+            w = rng();
+        }
+        std::memcpy(out.data(), words.data(), sizeof(out));
+        if constexpr (std::floating_point<T>) {
+            for (auto& v : out) {
+                if (!std::isfinite(v)) {
+                    v = draw_any<T>(rng);
+                }
+            }
+        }
+    } else {
+        for (auto& v : out) {
+            v = draw_any<T>(rng);
+        }
+    }
+}
+
+// Whether bound lies below / above every value of integer T, compared
+// without converting it to T
+template <typename T, typename B> constexpr bool below_range(B bound) {
+    if constexpr (std::integral<B>) {
+        return std::cmp_less(bound, std::numeric_limits<T>::lowest());
+    } else {
+        return bound < static_cast<B>(std::numeric_limits<T>::lowest());
+    }
+}
+
+template <typename T, typename B> constexpr bool above_range(B bound) {
+    if constexpr (std::integral<B>) {
+        return std::cmp_greater(bound, std::numeric_limits<T>::max());
+    } else {
+        // Without enough digits, T's max rounds up to the next power of two
+        const B max = static_cast<B>(std::numeric_limits<T>::max());
+        if constexpr (std::numeric_limits<B>::digits >=
+                      std::numeric_limits<T>::digits) {
+            return bound > max;
+        } else {
+            return bound >= max;
+        }
+    }
+}
+
+// Smallest T >= bound / largest T <= bound (integer T, any bound type),
+// clamped to T's range
+template <typename T, typename B> constexpr T ceil_to(B bound) {
+    if (below_range<T>(bound)) {
+        return std::numeric_limits<T>::lowest();
+    }
+    if (above_range<T>(bound)) {
+        return std::numeric_limits<T>::max();
+    }
+    const T t = static_cast<T>(bound);
+    return static_cast<B>(t) < bound ? static_cast<T>(t + 1) : t;
+}
+
+template <typename T, typename B> constexpr T floor_to(B bound) {
+    if (below_range<T>(bound)) {
+        return std::numeric_limits<T>::lowest();
+    }
+    if (above_range<T>(bound)) {
+        return std::numeric_limits<T>::max();
+    }
+    const T t = static_cast<T>(bound);
+    return static_cast<B>(t) > bound ? static_cast<T>(t - 1) : t;
+}
+
+// Whether PredT, default-constructed, rejects v; false when it cannot be
+// constructed, so generate never relies on such a value being invalid
+template <typename PredT, typename T> constexpr bool rejects(T v) {
+    if constexpr (std::is_default_constructible_v<PredT> &&
+                  std::predicate<const PredT&, T>) {
+        return !PredT{}(v);
+    } else {
+        return false;
+    }
+}
+
+template <typename Sampler> struct sampled_predicate;
+
+template <typename PredT>
+struct sampled_predicate<traits::sampler<PredT>> {
+    using type = PredT;
+};
+
+// Base for samplers of predicates that hold exactly on one closed range of
+// T; Derived provides range<T>() -> std::pair<T, T>
+template <typename Derived> struct range_sampler {
+    template <typename T, typename Rng>
+        requires requires { Derived::template range<T>(); }
+    static T draw(Rng& rng) {
+        const auto [lo, hi] = Derived::template range<T>();
+        if (hi < lo) {
+            throw refinement_error(
+                std::string("generate: no value of the type satisfies the "
+                            "predicate"));
+        }
+        return uniform_in(rng, lo, hi);
+    }
+
+    template <typename T, typename Rng>
+        requires requires { Derived::template range<T>(); }
+    static T draw_invalid(Rng& rng) {
+        using PredT = typename sampled_predicate<Derived>::type;
+        const auto [lo, hi] = Derived::template range<T>();
+        if (hi < lo) {
+            return draw_any<T>(rng);
+        }
+        return uniform_outside(rng, lo, hi,
+                               [](T v) { return rejects<PredT>(v); });
+    }
+};
+
+} // namespace detail
+
+// Direct samplers for predicates
+namespace traits {
+
+// sampler<PredT>::draw<T>(rng) returns a value of T satisfying the
+// predicate and draw_invalid<T>(rng) one violating it, each from a single
+// draw. Either may be missing (or constrained away for some T); generate
+// then uses rejection sampling for that direction.
+template <typename PredT> struct sampler {};
+
+// Interval-like predicates: uniform over [lo, hi]
+template <typename PredT>
+    requires requires {
+        PredT::lo;
+        PredT::hi;
+    }
+struct sampler<PredT> : detail::range_sampler<sampler<PredT>> {
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    static constexpr std::pair<T, T> range() {
+        if constexpr (std::integral<T>) {
+            if (detail::above_range<T>(PredT::lo) ||
+                detail::below_range<T>(PredT::hi)) {
+                return {std::numeric_limits<T>::max(),
+                        std::numeric_limits<T>::lowest()}; // empty
+            }
+            return {detail::ceil_to<T>(PredT::lo),
+                    detail::floor_to<T>(PredT::hi)};
+        } else {
+            return {static_cast<T>(PredT::lo), static_cast<T>(PredT::hi)};
+        }
+    }
+};
+
+template <>
+struct sampler<std::remove_cv_t<decltype(Positive)>>
+    : detail::range_sampler<sampler<std::remove_cv_t<decltype(Positive)>>> {
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    static constexpr std::pair<T, T> range() {
+        if constexpr (std::integral<T>) {
+            return {T{1}, std::numeric_limits<T>::max()};
+        } else {
+            return {std::numeric_limits<T>::denorm_min(),
+                    std::numeric_limits<T>::max()};
+        }
+    }
+};
+
+template <>
+struct sampler<std::remove_cv_t<decltype(Negative)>>
+    : detail::range_sampler<sampler<std::remove_cv_t<decltype(Negative)>>> {
+    template <typename T>
+        requires std::is_signed_v<T>
+    static constexpr std::pair<T, T> range() {
+        if constexpr (std::integral<T>) {
+            return {std::numeric_limits<T>::lowest(), T{-1}};
+        } else {
+            return {std::numeric_limits<T>::lowest(),
+                    -std::numeric_limits<T>::denorm_min()};
+        }
+    }
+};
+
+template <>
+struct sampler<std::remove_cv_t<decltype(NonNegative)>>
+    : detail::range_sampler<
+          sampler<std::remove_cv_t<decltype(NonNegative)>>> {
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    static constexpr std::pair<T, T> range() {
+        return {T{0}, std::numeric_limits<T>::max()};
+    }
+};
+
+template <>
+struct sampler<std::remove_cv_t<decltype(NonPositive)>>
+    : detail::range_sampler<
+          sampler<std::remove_cv_t<decltype(NonPositive)>>> {
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    static constexpr std::pair<T, T> range() {
+        return {std::numeric_limits<T>::lowest(), T{0}};
+    }
+};
+
+template <>
+struct sampler<std::remove_cv_t<decltype(Zero)>>
+    : detail::range_sampler<sampler<std::remove_cv_t<decltype(Zero)>>> {
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    static constexpr std::pair<T, T> range() {
+        return {T{0}, T{0}};
+    }
+};
+
+template <>
+struct sampler<std::remove_cv_t<decltype(Normalized)>>
+    : detail::range_sampler<
+          sampler<std::remove_cv_t<decltype(Normalized)>>> {
+    template <typename T>
+        requires std::is_signed_v<T>
+    static constexpr std::pair<T, T> range() {
+        return {T{-1}, T{1}};
+    }
+};
+
+// Finite: every finite value; the infinities are the invalid ones
+template <>
+struct sampler<std::remove_cv_t<decltype(Finite)>>
+    : detail::range_sampler<sampler<std::remove_cv_t<decltype(Finite)>>> {
+    template <typename T>
+        requires std::floating_point<T>
+    static constexpr std::pair<T, T> range() {
+        return {std::numeric_limits<T>::lowest(),
+                std::numeric_limits<T>::max()};
+    }
+};
+
+// NonZero: skip zero in a range one shorter than T's
+template <> struct sampler<std::remove_cv_t<decltype(NonZero)>> {
+    template <std::integral T, typename Rng> static T draw(Rng& rng) {
+        const T v = detail::uniform_in(rng, std::numeric_limits<T>::lowest(),
+                                       static_cast<T>(
+                                           std::numeric_limits<T>::max() - 1));
+        return v >= T{0} ? static_cast<T>(v + 1) : v;
+    }
+
+    template <typename T, typename Rng>
+        requires std::is_arithmetic_v<T>
+    static T draw_invalid(Rng&) {
+        return T{0};
+    }
+};
+
+// Even/Odd: 2k and 2k + 1 for a uniform k
+template <> struct sampler<std::remove_cv_t<decltype(Even)>> {
+    template <std::integral T, typename Rng> static T draw(Rng& rng) {
+        using limits = std::numeric_limits<T>;
+        return static_cast<T>(
+            detail::uniform_in(rng, static_cast<T>(limits::lowest() / 2),
+                               static_cast<T>(limits::max() / 2)) *
+            2);
+    }
+
+    template <std::integral T, typename Rng> static T draw_invalid(Rng& rng) {
+        using limits = std::numeric_limits<T>;
+        return static_cast<T>(
+            detail::uniform_in(rng, static_cast<T>(limits::lowest() / 2),
+                               static_cast<T>((limits::max() - 1) / 2)) *
+                2 +
+            1);
+    }
+};
+
+template <> struct sampler<std::remove_cv_t<decltype(Odd)>> {
+    template <std::integral T, typename Rng> static T draw(Rng& rng) {
+        return sampler<std::remove_cv_t<decltype(Even)>>::draw_invalid<T>(
+            rng);
+    }
+
+    template <std::integral T, typename Rng> static T draw_invalid(Rng& rng) {
+        return sampler<std::remove_cv_t<decltype(Even)>>::draw<T>(rng);
+    }
+};
+
+// PowerOfTwo: 1 << k for a uniform exponent k
+template <> struct sampler<std::remove_cv_t<decltype(PowerOfTwo)>> {
+    template <std::integral T, typename Rng>
+        requires(!std::same_as<T, bool>)
+    static T draw(Rng& rng) {
+        const int k =
+            detail::uniform_in(rng, 0, std::numeric_limits<T>::digits - 1);
+        return static_cast<T>(T{1} << k);
+    }
+};
+
+// Always: any value, and no invalid ones
+template <>
+struct sampler<std::remove_cv_t<decltype(Always)>>
+    : detail::range_sampler<sampler<std::remove_cv_t<decltype(Always)>>> {
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    static constexpr std::pair<T, T> range() {
+        return {std::numeric_limits<T>::lowest(),
+                std::numeric_limits<T>::max()};
+    }
+};
+
+} // namespace traits
+
+namespace detail {
+
+template <auto Pred>
+using sampler_for = traits::sampler<std::remove_cv_t<decltype(Pred)>>;
+
+template <auto Pred, typename T, typename Rng>
+concept samples_valid = requires(Rng& rng) {
+    { sampler_for<Pred>::template draw<T>(rng) } -> std::same_as<T>;
+};
+
+template <auto Pred, typename T, typename Rng>
+concept samples_invalid = requires(Rng& rng) {
+    { sampler_for<Pred>::template draw_invalid<T>(rng) } -> std::same_as<T>;
+};
+
+// Rejection sampling in blocks: draw bulk_block candidates from the whole
+// range of T, evaluate the predicate over the block without branches into a
+// bit mask, then hand out the candidates whose result equals Accept
+template <auto Pred, typename T, bool Accept> class rejection_sampler {
+  public:
+    explicit rejection_sampler(std::size_t max_rejections) noexcept
+        : max_rejections_(max_rejections) {}
+
+    template <typename Rng> T next(Rng& rng) {
+        std::size_t rejected = 0;
+        while (mask_ == 0) {
+            if (rejected >= max_rejections_) {
+                throw refinement_error(
+                    std::string("generate: no candidate ") +
+                    (Accept ? "satisfied" : "violated") + " the predicate in " +
+                    std::to_string(rejected) + " draws");
+            }
+            refill(rng);
+            rejected += bulk_block;
+        }
+        const int j = std::countr_zero(mask_);
+        mask_ &= mask_ - 1;
+        return block_[static_cast<std::size_t>(j)];
+    }
+
+  private:
+    template <typename Rng> void refill(Rng& rng) {
+        fill_any(rng, block_);
+        std::uint64_t mask = 0;
+        for (std::size_t j = 0; j < bulk_block; ++j) {
+            mask |= std::uint64_t{static_cast<bool>(Pred(block_[j])) == Accept}
+                    << j;
+        }
+        mask_ = mask;
+    }
+
+    std::array<T, bulk_block> block_{};
+    std::uint64_t mask_ = 0;
+    std::size_t max_rejections_;
+};
+
+// Values satisfying (Valid) or violating Pred, drawn directly when the
+// predicate's sampler supports it and by rejection otherwise
+template <auto Pred, typename T, bool Valid> class sample_source {
+  public:
+    explicit sample_source(std::size_t max_rejections) noexcept
+        : rejection_(max_rejections) {}
+
+    template <typename Rng> T next(Rng& rng) {
+        if constexpr (Valid && samples_valid<Pred, T, Rng>) {
+            return sampler_for<Pred>::template draw<T>(rng);
+        } else if constexpr (!Valid && samples_invalid<Pred, T, Rng>) {
+            return sampler_for<Pred>::template draw_invalid<T>(rng);
+        } else {
+            return rejection_.next(rng);
+        }
+    }
+
+  private:
+    rejection_sampler<Pred, T, Valid> rejection_;
+};
+
+} // namespace detail
+
+// True if generate<RefinedT> draws valid values directly (no rejection)
+template <typename RefinedT, typename Rng = std::mt19937_64>
+inline constexpr bool direct_sampling =
+    detail::samples_valid<RefinedT::predicate, typename RefinedT::value_type,
+                          Rng>;
+
+// Fill `out` with random values for RefinedT: round(invalid_fraction *
+// out.size()) of them, at uniformly random positions, violate the
+// predicate; the rest satisfy it
+template <typename RefinedT, typename Rng>
+    requires is_refined<RefinedT> &&
+             std::is_arithmetic_v<typename RefinedT::value_type> &&
+             std::uniform_random_bit_generator<Rng>
+void generate(Rng& rng, std::span<typename RefinedT::value_type> out,
+              generate_options options = {}) {
+    using T = typename RefinedT::value_type;
+    if (!(options.invalid_fraction >= 0.0 && options.invalid_fraction <= 1.0)) {
+        throw std::invalid_argument(
+            "generate: invalid_fraction must be in [0, 1]");
+    }
+
+    std::size_t invalid = static_cast<std::size_t>(
+        std::llround(options.invalid_fraction * out.size()));
+    detail::sample_source<RefinedT::predicate, T, true> valid_values(
+        options.max_rejections);
+    detail::sample_source<RefinedT::predicate, T, false> invalid_values(
+        options.max_rejections);
+
+    // Selection sampling: each position is invalid with probability
+    // (invalid left) / (positions left), which places exactly `invalid`
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        const std::size_t left = out.size() - i;
+        if (invalid > 0 &&
+            detail::uniform_in(rng, std::size_t{0}, left - 1) < invalid) {
+            out[i] = invalid_values.next(rng);
+            --invalid;
+        } else {
+            out[i] = valid_values.next(rng);
+        }
+    }
+}
+
+// Fill `out` with random refined values (all valid)
+template <typename RefinedT, typename Rng>
+    requires is_refined<RefinedT> &&
+             std::is_arithmetic_v<typename RefinedT::value_type> &&
+             std::uniform_random_bit_generator<Rng>
+void generate(Rng& rng, std::span<RefinedT> out,
+              std::size_t max_rejections = generate_options{}.max_rejections) {
+    detail::sample_source<RefinedT::predicate, typename RefinedT::value_type,
+                          true>
+        values(max_rejections);
+    for (auto& r : out) {
+        r = RefinedT(values.next(rng), assume_valid);
+    }
+}
+
+} // namespace refinery
+
+#endif // REFINERY_GENERATE_HPP
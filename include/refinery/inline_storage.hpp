@@ -0,0 +1,351 @@
+// inline_storage.hpp - Fixed-capacity inline backends for size-bounded values
+// Part of the C++26 Refinement Types Library
+//
+// A SizeAtMost(N) / SizeInRange(lo, N) refinement proves a string or vector
+// never exceeds N elements, so it can live in inline storage instead of the
+// heap. inline_string<N> and static_vector<T, N> provide that storage, and
+// CompactRefined<T, Pred> selects them automatically for small bounds.
+
+#ifndef REFINERY_INLINE_STORAGE_HPP
+#define REFINERY_INLINE_STORAGE_HPP
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core.hpp"
+#include "predicates.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+// Smallest unsigned integer type that can hold N
+template <std::size_t N>
+using narrow_size_t = std::conditional_t<
+    N <= std::numeric_limits<std::uint8_t>::max(), std::uint8_t,
+    std::conditional_t<
+        N <= std::numeric_limits<std::uint16_t>::max(), std::uint16_t,
+        std::conditional_t<N <= std::numeric_limits<std::uint32_t>::max(),
+                           std::uint32_t, std::size_t>>>;
+
+} // namespace detail
+
+// Null-terminated string with inline capacity for N characters
+template <std::size_t N> class inline_string {
+  public:
+    using value_type = char;
+    using size_type = detail::narrow_size_t<N>;
+    using iterator = char*;
+    using const_iterator = const char*;
+    static constexpr std::size_t max_size = N;
+
+    constexpr inline_string() noexcept = default;
+
+    // Throws std::length_error if str is longer than N
+    constexpr inline_string(std::string_view str) { assign(str); }
+    constexpr inline_string(const char* str)
+        : inline_string(std::string_view(str)) {}
+
+    constexpr void assign(std::string_view str) {
+        if (str.size() > N) {
+            throw std::length_error("inline_string: capacity exceeded");
+        }
+        std::copy(str.begin(), str.end(), data_);
+        size_ = static_cast<size_type>(str.size());
+        data_[size_] = '\0';
+    }
+
+    constexpr void push_back(char c) {
+        if (size_ == N) {
+            throw std::length_error("inline_string: capacity exceeded");
+        }
+        data_[size_++] = c;
+        data_[size_] = '\0';
+    }
+
+    constexpr void append(std::string_view str) {
+        if (str.size() > N - size_) {
+            throw std::length_error("inline_string: capacity exceeded");
+        }
+        std::copy(str.begin(), str.end(), data_ + size_);
+        size_ = static_cast<size_type>(size_ + str.size());
+        data_[size_] = '\0';
+    }
+
+    constexpr void clear() noexcept {
+        size_ = 0;
+        data_[0] = '\0';
+    }
+
+    [[nodiscard]] constexpr size_type size() const noexcept { return size_; }
+    [[nodiscard]] constexpr size_type length() const noexcept { return size_; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept {
+        return N;
+    }
+
+    [[nodiscard]] constexpr const char* data() const noexcept { return data_; }
+    [[nodiscard]] constexpr const char* c_str() const noexcept {
+        return data_;
+    }
+    [[nodiscard]] constexpr char operator[](std::size_t i) const noexcept {
+        return data_[i];
+    }
+
+    [[nodiscard]] constexpr const_iterator begin() const noexcept {
+        return data_;
+    }
+    [[nodiscard]] constexpr const_iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const noexcept {
+        return {data_, size_};
+    }
+    [[nodiscard]] constexpr operator std::string_view() const noexcept {
+        return view();
+    }
+    [[nodiscard]] std::string str() const { return std::string(view()); }
+
+    [[nodiscard]] friend constexpr bool operator==(const inline_string& lhs,
+                                                   const inline_string& rhs) {
+        return lhs.view() == rhs.view();
+    }
+    [[nodiscard]] friend constexpr bool operator==(const inline_string& lhs,
+                                                   std::string_view rhs) {
+        return lhs.view() == rhs;
+    }
+    [[nodiscard]] friend constexpr auto operator<=>(const inline_string& lhs,
+                                                    const inline_string& rhs) {
+        return lhs.view() <=> rhs.view();
+    }
+
+  private:
+    char data_[N + 1] = {};
+    size_type size_ = 0;
+};
+
+// Vector with inline capacity for N elements; never allocates
+template <typename T, std::size_t N> class static_vector {
+    static_assert(N > 0, "static_vector requires a non-zero capacity");
+
+  public:
+    using value_type = T;
+    using size_type = detail::narrow_size_t<N>;
+    using iterator = T*;
+    using const_iterator = const T*;
+    static constexpr std::size_t max_size = N;
+
+    static_vector() noexcept = default;
+
+    // Throws std::length_error if the input has more than N elements
+    static_vector(std::initializer_list<T> init)
+        : static_vector(std::span<const T>(init.begin(), init.size())) {}
+
+    explicit static_vector(std::span<const T> values) {
+        check_capacity(values.size());
+        std::uninitialized_copy(values.begin(), values.end(), data());
+        size_ = static_cast<size_type>(values.size());
+    }
+
+    static_vector(const static_vector& other)
+        : static_vector(std::span<const T>(other.data(), other.size())) {}
+
+    static_vector(static_vector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        std::uninitialized_move(other.begin(), other.end(), data());
+        size_ = other.size_;
+        other.clear();
+    }
+
+    static_vector& operator=(const static_vector& other) {
+        if (this != &other) {
+            clear();
+            std::uninitialized_copy(other.begin(), other.end(), data());
+            size_ = other.size_;
+        }
+        return *this;
+    }
+
+    static_vector& operator=(static_vector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            std::uninitialized_move(other.begin(), other.end(), data());
+            size_ = other.size_;
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~static_vector() { clear(); }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template <typename... Args> T& emplace_back(Args&&... args) {
+        check_capacity(size_ + std::size_t{1});
+        T* slot =
+            std::construct_at(data() + size_, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void pop_back() noexcept {
+        --size_;
+        std::destroy_at(data() + size_);
+    }
+
+    void clear() noexcept {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept {
+        return N;
+    }
+
+    [[nodiscard]] T* data() noexcept {
+        return std::launder(reinterpret_cast<T*>(storage_));
+    }
+    [[nodiscard]] const T* data() const noexcept {
+        return std::launder(reinterpret_cast<const T*>(storage_));
+    }
+
+    [[nodiscard]] T& operator[](std::size_t i) noexcept { return data()[i]; }
+    [[nodiscard]] const T& operator[](std::size_t i) const noexcept {
+        return data()[i];
+    }
+    [[nodiscard]] const T& front() const noexcept { return data()[0]; }
+    [[nodiscard]] const T& back() const noexcept { return data()[size_ - 1]; }
+
+    [[nodiscard]] iterator begin() noexcept { return data(); }
+    [[nodiscard]] iterator end() noexcept { return data() + size_; }
+    [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+    [[nodiscard]] const_iterator end() const noexcept {
+        return data() + size_;
+    }
+
+    [[nodiscard]] operator std::span<const T>() const noexcept {
+        return {data(), size_};
+    }
+
+    [[nodiscard]] friend bool operator==(const static_vector& lhs,
+                                         const static_vector& rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+  private:
+    static void check_capacity(std::size_t n) {
+        if (n > N) {
+            throw std::length_error("static_vector: capacity exceeded");
+        }
+    }
+
+    alignas(T) std::byte storage_[sizeof(T) * N];
+    size_type size_ = 0;
+};
+
+// --- Automatic storage selection ---
+
+// Largest inline footprint (in bytes) CompactRefined will choose over the heap
+inline constexpr std::size_t max_inline_bytes = 1024;
+
+namespace traits {
+
+template <auto Pred>
+concept size_bounded = std::same_as<std::remove_cv_t<decltype(Pred)>,
+                                    SizeBounds>;
+
+// Storage used for T under refinement Pred (T itself unless Pred bounds the
+// size tightly enough for an inline backend)
+template <typename T, auto Pred> struct compact_storage {
+    using type = T;
+};
+
+template <auto Pred>
+    requires size_bounded<Pred> && (Pred.max_size < max_inline_bytes)
+struct compact_storage<std::string, Pred> {
+    using type = inline_string<Pred.max_size>;
+};
+
+template <typename T, auto Pred>
+    requires size_bounded<Pred> && (Pred.max_size > 0) &&
+             (Pred.max_size <= max_inline_bytes / sizeof(T))
+struct compact_storage<std::vector<T>, Pred> {
+    using type = static_vector<T, Pred.max_size>;
+};
+
+} // namespace traits
+
+template <typename T, auto Pred>
+using compact_storage_t = typename traits::compact_storage<T, Pred>::type;
+
+// Refined<T, Pred> with inline storage when Pred bounds the size:
+// CompactRefined<std::string, SizeAtMost(16)> is
+// Refined<inline_string<16>, SizeAtMost(16)>
+template <typename T, auto Pred>
+using CompactRefined = Refined<compact_storage_t<T, Pred>, Pred>;
+
+// Build a compact refined value from its source representation (e.g.
+// std::string_view or std::span<const T>). The predicate is checked on the
+// source first, so over-long input is rejected before anything is copied.
+template <typename RefinedT, typename Source>
+    requires std::constructible_from<typename RefinedT::value_type,
+                                     const Source&>
+[[nodiscard]] constexpr std::optional<RefinedT>
+try_refine_compact(const Source& source) {
+    detail::note_construction<RefinedT, construction::runtime_check>();
+    if (!RefinedT::predicate(source)) {
+        return std::nullopt;
+    }
+    return RefinedT(typename RefinedT::value_type(source),
+                    detail::adopt_checked);
+}
+
+// Runtime checked variant of try_refine_compact
+// Throws refinement_error if predicate is not satisfied
+template <typename RefinedT, typename Source>
+    requires std::constructible_from<typename RefinedT::value_type,
+                                     const Source&>
+[[nodiscard]] constexpr RefinedT refine_compact(const Source& source) {
+    detail::note_construction<RefinedT, construction::runtime_check>();
+    if (!RefinedT::predicate(source)) {
+        throw refinement_error(source);
+    }
+    return RefinedT(typename RefinedT::value_type(source),
+                    detail::adopt_checked);
+}
+
+} // namespace refinery
+
+// Formatter specialization so std::format can print
+// inline strings like std::string
+template <std::size_t N>
+struct std::formatter<refinery::inline_string<N>>
+    : std::formatter<std::string_view> {
+    template <typename FormatContext>
+    auto format(const refinery::inline_string<N>& str,
+                FormatContext& ctx) const {
+        return std::formatter<std::string_view>::format(str.view(), ctx);
+    }
+};
+
+#endif // REFINERY_INLINE_STORAGE_HPP
@@ -8,54 +8,15 @@
 #include <limits>
 #include <type_traits>
 
-#include "refined_type.hpp"
+#include "core.hpp"
 
 namespace refinery {
 
-// Structural interval predicate: closed [Lo, Hi]
-// Valid as NTTP because it has no data members (bounds are template
-// parameters).
-template <auto Lo, auto Hi> struct Interval {
-    static constexpr auto lo = Lo;
-    static constexpr auto hi = Hi;
-
-    constexpr bool operator()(auto v) const { return v >= Lo && v <= Hi; }
-};
-
-// Trait to detect interval predicates
-namespace traits {
-
-template <typename T> struct interval_traits : std::false_type {};
-
-template <auto Lo, auto Hi>
-struct interval_traits<Interval<Lo, Hi>> : std::true_type {
-    static constexpr auto lo = Lo;
-    static constexpr auto hi = Hi;
-};
-
-} // namespace traits
-
-// Concept for interval predicates (takes an NTTP predicate value)
-template <auto Pred>
-concept interval_predicate = traits::interval_traits<decltype(Pred)>::value;
-
 // Compile-time interval arithmetic
 namespace interval_math {
 
 namespace detail {
 
-template <auto A, auto B> consteval auto ct_min() { return A < B ? A : B; }
-
-template <auto A, auto B> consteval auto ct_max() { return A > B ? A : B; }
-
-template <auto A, auto B, auto C, auto D> consteval auto min4() {
-    return ct_min<ct_min<A, B>(), ct_min<C, D>()>();
-}
-
-template <auto A, auto B, auto C, auto D> consteval auto max4() {
-    return ct_max<ct_max<A, B>(), ct_max<C, D>()>();
-}
-
 // Saturating arithmetic for compile-time interval bound computation.
 // Clamps to numeric limits instead of overflowing.
 template <typename T> consteval T sat_add(T a, T b) {
@@ -134,46 +95,82 @@ template <typename T> consteval T sat_neg(T a) {
     return -a;
 }
 
+template <typename T> consteval T min4(T a, T b, T c, T d) {
+    const T ab = a < b ? a : b;
+    const T cd = c < d ? c : d;
+    return ab < cd ? ab : cd;
+}
+
+template <typename T> consteval T max4(T a, T b, T c, T d) {
+    const T ab = a > b ? a : b;
+    const T cd = c > d ? c : d;
+    return ab > cd ? ab : cd;
+}
+
 } // namespace detail
 
+// Interval bounds as a structural value. Bound computation is done on these
+// values by plain consteval functions (instantiated once per element type),
+// and the result predicate is interval_of<bounds>: keyed on the resulting
+// bounds only, so every expression yielding the same bounds shares one
+// Interval and Refined specialization.
+template <typename T> struct bounds {
+    T lo;
+    T hi;
+};
+
+template <auto Lo, auto Hi>
+consteval bounds<std::remove_cv_t<decltype(Lo)>> bounds_of(Interval<Lo, Hi>) {
+    return {Lo, Hi};
+}
+
+template <auto B> inline constexpr Interval<B.lo, B.hi> interval_of{};
+
+template <typename T, typename U>
+consteval bounds<T> add_bounds(bounds<T> a, bounds<U> b) {
+    return {detail::sat_add<T>(a.lo, b.lo), detail::sat_add<T>(a.hi, b.hi)};
+}
+
+template <typename T, typename U>
+consteval bounds<T> sub_bounds(bounds<T> a, bounds<U> b) {
+    return {detail::sat_sub<T>(a.lo, b.hi), detail::sat_sub<T>(a.hi, b.lo)};
+}
+
+template <typename T, typename U>
+consteval bounds<T> mul_bounds(bounds<T> a, bounds<U> b) {
+    const T ac = detail::sat_mul<T>(a.lo, b.lo);
+    const T ad = detail::sat_mul<T>(a.lo, b.hi);
+    const T bc = detail::sat_mul<T>(a.hi, b.lo);
+    const T bd = detail::sat_mul<T>(a.hi, b.hi);
+    return {detail::min4(ac, ad, bc, bd), detail::max4(ac, ad, bc, bd)};
+}
+
+template <typename T> consteval bounds<T> negate_bounds(bounds<T> a) {
+    return {detail::sat_neg<T>(a.hi), detail::sat_neg<T>(a.lo)};
+}
+
 template <auto P1, auto P2>
     requires interval_predicate<P1> && interval_predicate<P2>
 consteval auto add_intervals() {
-    using T = decltype(P1.lo);
-    constexpr auto lo = detail::sat_add<T>(P1.lo, P2.lo);
-    constexpr auto hi = detail::sat_add<T>(P1.hi, P2.hi);
-    return Interval<lo, hi>{};
+    return interval_of<add_bounds(bounds_of(P1), bounds_of(P2))>;
 }
 
 template <auto P1, auto P2>
     requires interval_predicate<P1> && interval_predicate<P2>
 consteval auto sub_intervals() {
-    using T = decltype(P1.lo);
-    constexpr auto lo = detail::sat_sub<T>(P1.lo, P2.hi);
-    constexpr auto hi = detail::sat_sub<T>(P1.hi, P2.lo);
-    return Interval<lo, hi>{};
+    return interval_of<sub_bounds(bounds_of(P1), bounds_of(P2))>;
 }
 
 template <auto P1, auto P2>
     requires interval_predicate<P1> && interval_predicate<P2>
 consteval auto mul_intervals() {
-    using T = decltype(P1.lo);
-    constexpr auto ac = detail::sat_mul<T>(P1.lo, P2.lo);
-    constexpr auto ad = detail::sat_mul<T>(P1.lo, P2.hi);
-    constexpr auto bc = detail::sat_mul<T>(P1.hi, P2.lo);
-    constexpr auto bd = detail::sat_mul<T>(P1.hi, P2.hi);
-    constexpr auto lo = detail::min4<ac, ad, bc, bd>();
-    constexpr auto hi = detail::max4<ac, ad, bc, bd>();
-    return Interval<lo, hi>{};
+    return interval_of<mul_bounds(bounds_of(P1), bounds_of(P2))>;
 }
 
 template <auto P>
     requires interval_predicate<P>
 consteval auto negate_interval() {
-    using T = decltype(P.lo);
-    constexpr auto lo = detail::sat_neg<T>(P.hi);
-    constexpr auto hi = detail::sat_neg<T>(P.lo);
-    return Interval<lo, hi>{};
+    return interval_of<negate_bounds(bounds_of(P))>;
 }
 
 } // namespace interval_math
@@ -359,10 +356,6 @@ template <typename T, auto P>
         return detail::make_interval_result<result_pred>(lhs.get() * rhs.get());
 }
 
-// Convenience alias
-template <typename T, auto Lo, auto Hi>
-using IntervalRefined = Refined<T, Interval<Lo, Hi>{}>;
-
 } // namespace refinery
 
 #endif // REFINERY_INTERVAL_HPP
@@ -0,0 +1,186 @@
+// inventory.hpp - Which refined types a program uses, and how
+// Part of the C++26 Refinement Types Library
+//
+// describe<R>() reflects on a Refined type: its name, predicate kind, bounds
+// and whether it takes part in interval arithmetic (interval.hpp), where
+// results carry their bounds in the type and need no runtime check.
+//
+// Built with REFINERY_INVENTORY defined (for every translation unit, e.g.
+// the REFINERY_INVENTORY CMake option), each Refined constructor a program
+// uses registers its (type, construction path) pair before main, and the
+// runtime paths count how often they run. inventory() lists them with the
+// most runtime checks first; hot checked types that are intervals are the
+// ones to tighten so the check moves to compile time.
+//
+//   std::fputs(refinery::inventory_report().c_str(), stderr);
+
+#ifndef REFINERY_INVENTORY_HPP
+#define REFINERY_INVENTORY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <meta>
+
+#include "core.hpp"
+#include "diagnostics.hpp"
+
+namespace refinery {
+
+// What is known about a refined type's predicate
+enum class predicate_kind : unsigned char {
+    interval, // Interval<Lo, Hi>
+    bounded,  // other predicate type with static lo/hi members
+    opaque,   // anything else (lambdas, compositions)
+};
+
+// Compile-time description of a Refined type
+struct refined_info {
+    std::string_view name;
+    std::string_view value_type;
+    std::string_view predicate;
+    predicate_kind kind;
+    bool interval_structural; // results of arithmetic keep static bounds
+    std::string_view lo;      // empty for opaque predicates
+    std::string_view hi;
+};
+
+template <typename R>
+    requires is_refined<R>
+consteval refined_info describe() {
+    using namespace std::meta;
+    using T = typename R::value_type;
+    using PredT = std::remove_cv_t<decltype(R::predicate)>;
+
+    refined_info info{};
+    info.name = define_static_string(display_string_of(^^R));
+    info.value_type = define_static_string(display_string_of(^^T));
+    info.predicate = define_static_string(display_string_of(^^PredT));
+    info.kind = predicate_kind::opaque;
+    info.interval_structural = interval_predicate<R::predicate>;
+    if constexpr (detail::has_interval_bounds<R::predicate>) {
+        info.kind = interval_predicate<R::predicate> ? predicate_kind::interval
+                                                     : predicate_kind::bounded;
+        info.lo = define_static_string(detail::format_value(PredT::lo));
+        info.hi = define_static_string(detail::format_value(PredT::hi));
+    }
+    return info;
+}
+
+// One construction path of one Refined type; count is the number of runtime
+// constructions (always 0 for compile_time)
+struct inventory_entry {
+    refined_info type;
+    construction path;
+    std::uint64_t count;
+};
+
+namespace detail {
+
+template <typename R> inline constexpr refined_info refined_info_v =
+    describe<R>();
+
+// Registered by its constructor during static initialization (also from
+// shared libraries loaded later), never unlinked
+struct construction_record {
+    const refined_info* type;
+    construction path;
+    std::atomic<std::uint64_t> count{0};
+    construction_record* next = nullptr;
+
+    construction_record(const refined_info& t, construction p) noexcept;
+};
+
+inline constinit std::atomic<construction_record*> construction_records{
+    nullptr};
+
+inline construction_record::construction_record(const refined_info& t,
+                                                construction p) noexcept
+    : type(&t), path(p) {
+    next = construction_records.load(std::memory_order_relaxed);
+    while (!construction_records.compare_exchange_weak(
+        next, this, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+template <typename R, construction Path> struct construction_site {
+    static inline construction_record record{refined_info_v<R>, Path};
+};
+
+#ifdef REFINERY_INVENTORY
+// Naming the record instantiates it, which registers the pair even for
+// paths that only run during constant evaluation
+template <typename R, construction Path>
+constexpr void note_construction(std::size_t count) noexcept {
+    if consteval {
+        static_cast<void>(&construction_site<R, Path>::record);
+    } else {
+        construction_site<R, Path>::record.count.fetch_add(
+            count, std::memory_order_relaxed);
+    }
+}
+#endif
+
+[[nodiscard]] constexpr std::string_view
+construction_name(construction path) noexcept {
+    switch (path) {
+    case construction::compile_time:
+        return "compile_time";
+    case construction::runtime_check:
+        return "runtime_check";
+    case construction::assume_valid:
+        return "assume_valid";
+    case construction::implied:
+        return "implied";
+    }
+    return "?";
+}
+
+} // namespace detail
+
+// Every (Refined type, construction path) pair the program uses, runtime
+// checks first, most frequent first; empty without REFINERY_INVENTORY
+[[nodiscard]] inline std::vector<inventory_entry> inventory() {
+    std::vector<inventory_entry> entries;
+    for (auto* r = detail::construction_records.load(std::memory_order_acquire);
+         r != nullptr; r = r->next) {
+        entries.push_back(
+            {*r->type, r->path, r->count.load(std::memory_order_relaxed)});
+    }
+    std::ranges::sort(entries, {}, [](const inventory_entry& e) {
+        return std::tuple(e.path != construction::runtime_check, ~e.count,
+                          e.type.name, e.path);
+    });
+    return entries;
+}
+
+// inventory() as a table: path, count, predicate kind and bounds, type
+[[nodiscard]] inline std::string inventory_report() {
+    std::string out;
+    for (const auto& e : inventory()) {
+        std::string shape = "opaque";
+        if (e.type.kind != predicate_kind::opaque) {
+            shape = std::format(
+                "{} [{}, {}]",
+                e.type.kind == predicate_kind::interval ? "interval"
+                                                        : "bounded",
+                e.type.lo, e.type.hi);
+        }
+        out += std::format("{:<14} {:>12}  {:<24} {}\n",
+                           detail::construction_name(e.path), e.count, shape,
+                           e.type.name);
+    }
+    return out;
+}
+
+} // namespace refinery
+
+#endif // REFINERY_INVENTORY_HPP
@@ -0,0 +1,263 @@
+// modify.hpp - In-place modification with incremental revalidation
+// Part of the C++26 Refinement Types Library
+//
+// modify(refined, fn) hands `fn` mutable access to the value inside a
+// Refined (or RefinedVector) and re-establishes the predicate afterwards.
+// For container predicates that can be checked piecewise (AllElements,
+// Sorted), `fn` receives a tracked_view that records which elements were
+// written, and only those elements (plus their neighbours, for Sorted) are
+// re-checked. On failure every written element is restored and
+// refinement_error is thrown, so the refined value is never left invalid.
+
+#ifndef REFINERY_MODIFY_HPP
+#define REFINERY_MODIFY_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "compose.hpp"
+#include "core.hpp"
+#include "predicates.hpp"
+#include "vector.hpp"
+
+namespace refinery {
+
+// Traits for predicates that can be re-checked over part of a container
+namespace traits {
+
+// check(c, first, last) must return true iff the predicate still holds for c,
+// given that it held before and only elements in [first, last) changed.
+template <typename PredT> struct incremental : std::false_type {};
+
+// AllElements<P>: only the changed elements need checking
+template <typename PredT>
+    requires requires { PredT::element_predicate; }
+struct incremental<PredT> : std::true_type {
+    template <typename C>
+    static constexpr bool check(const C& c, std::size_t first,
+                                std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            if (!PredT::element_predicate(c[i]))
+                return false;
+        }
+        return true;
+    }
+};
+
+// Sorted: only the changed range and the boundaries around it
+template <>
+struct incremental<std::remove_cv_t<decltype(Sorted)>> : std::true_type {
+    template <typename C>
+    static constexpr bool check(const C& c, std::size_t first,
+                                std::size_t last) {
+        const std::size_t lo = first == 0 ? 0 : first - 1;
+        const std::size_t hi = std::min(last + 1, std::size(c));
+        for (std::size_t i = lo + 1; i < hi; ++i) {
+            if (c[i] < c[i - 1])
+                return false;
+        }
+        return true;
+    }
+};
+
+} // namespace traits
+
+template <auto Pred>
+concept incremental_predicate =
+    traits::incremental<std::remove_cv_t<decltype(Pred)>>::value;
+
+// Mutable view over contiguous elements that records every write access.
+// Reads through get() are not tracked; writes through operator[] or
+// mutable_span() mark the elements dirty and save their original values,
+// once per element however often it is written.
+template <typename T> class tracked_view {
+  public:
+    explicit tracked_view(std::span<T> data) noexcept : data_(data) {}
+
+    tracked_view(const tracked_view&) = delete;
+    tracked_view& operator=(const tracked_view&) = delete;
+
+    [[nodiscard]] std::size_t size() const noexcept { return data_.size(); }
+
+    // Read-only access (not tracked)
+    [[nodiscard]] const T& get(std::size_t i) const noexcept {
+        return data_[i];
+    }
+
+    // Write access to element i (tracked)
+    [[nodiscard]] T& operator[](std::size_t i) {
+        touch(i, i + 1);
+        return data_[i];
+    }
+
+    // Write access to [first, first + count) (tracked)
+    [[nodiscard]] std::span<T> mutable_span(std::size_t first,
+                                            std::size_t count) {
+        touch(first, first + count);
+        return data_.subspan(first, count);
+    }
+
+    // Touched ranges, sorted and merged
+    [[nodiscard]] std::vector<std::pair<std::size_t, std::size_t>>
+    dirty_ranges() const {
+        return {dirty_.begin(), dirty_.end()};
+    }
+
+    // Restore every touched element to its value before the first write
+    void rollback() noexcept(std::is_nothrow_move_assignable_v<T>) {
+        for (auto it = undo_.rbegin(); it != undo_.rend(); ++it) {
+            data_[it->first] = std::move(it->second);
+        }
+        undo_.clear();
+        dirty_.clear();
+    }
+
+  private:
+    // Save the elements of [first, last) outside every dirty range, then
+    // merge [first, last) with the ranges it overlaps or adjoins. Costs
+    // O(log k) in the number k of dirty ranges, plus the newly saved
+    // elements; dirty_ only changes once they are all saved.
+    void touch(std::size_t first, std::size_t last) {
+        if (first >= last) {
+            return;
+        }
+        auto lo = dirty_.upper_bound(first);
+        if (lo != dirty_.begin() && std::prev(lo)->second >= first) {
+            --lo;
+        }
+        auto hi = lo;
+        std::size_t i = first;
+        for (; hi != dirty_.end() && hi->first <= last; ++hi) {
+            save(i, hi->first);
+            i = std::max(i, hi->second);
+        }
+        save(i, last);
+
+        if (lo == hi) {
+            dirty_.emplace_hint(hi, first, last);
+            return;
+        }
+        const std::size_t begin = std::min(first, lo->first);
+        const std::size_t end = std::max(last, std::prev(hi)->second);
+        auto node = dirty_.extract(lo++);
+        dirty_.erase(lo, hi);
+        node.key() = begin;
+        node.mapped() = end;
+        dirty_.insert(hi, std::move(node));
+    }
+
+    void save(std::size_t first, std::size_t last) {
+        for (; first < last; ++first) {
+            undo_.emplace_back(first, data_[first]);
+        }
+    }
+
+    std::span<T> data_;
+    std::vector<std::pair<std::size_t, T>> undo_;
+    // Disjoint, non-adjacent [first, last) ranges of saved elements
+    std::map<std::size_t, std::size_t> dirty_;
+};
+
+namespace detail {
+
+struct refined_vector_access {
+    template <typename T, auto Pred, typename Alloc>
+    static std::span<T> values(RefinedVector<T, Pred, Alloc>& v) noexcept {
+        return {v.data(), v.size()};
+    }
+};
+
+// Run func on a tracked view of `values`, then re-check each touched range
+// [first, last) with check(first, last). Restores the touched elements and
+// rethrows on failure.
+template <typename T, typename Check, typename F>
+void modify_tracked(std::span<T> values, Check check, F& func) {
+    tracked_view<T> view{values};
+    try {
+        std::invoke(func, view);
+    } catch (...) {
+        view.rollback();
+        throw;
+    }
+    for (const auto& [first, last] : view.dirty_ranges()) {
+        if (!check(first, last)) {
+            view.rollback();
+            throw refinement_error(
+                "Refinement violation: modified elements do not satisfy "
+                "predicate");
+        }
+    }
+}
+
+} // namespace detail
+
+// Incremental modification of a container refinement (AllElements, Sorted).
+// Only the elements written through the tracked_view are re-checked.
+template <typename T, typename Alloc, auto Pred, typename F>
+    requires incremental_predicate<Pred> && std::invocable<F&, tracked_view<T>&>
+void modify(Refined<std::vector<T, Alloc>, Pred>& refined, F&& func) {
+    using traits_t = traits::incremental<std::remove_cv_t<decltype(Pred)>>;
+    using container_type = std::vector<T, Alloc>;
+
+    container_type values = std::move(refined).release();
+    struct restore {
+        Refined<container_type, Pred>& target;
+        container_type& values;
+        ~restore() {
+            target = Refined<container_type, Pred>(std::move(values),
+                                                   detail::adopt_checked);
+        }
+    } guard{refined, values};
+
+    detail::note_construction<Refined<container_type, Pred>,
+                              construction::runtime_check>();
+    detail::modify_tracked(
+        std::span<T>(values),
+        [&values](std::size_t first, std::size_t last) {
+            return traits_t::check(std::as_const(values), first, last);
+        },
+        func);
+}
+
+// Incremental modification of a RefinedVector, in place: touched elements
+// are checked
+template <typename T, auto Pred, typename Alloc, typename F>
+    requires std::invocable<F&, tracked_view<T>&>
+void modify(RefinedVector<T, Pred, Alloc>& refined, F&& func) {
+    const std::span<T> values = detail::refined_vector_access::values(refined);
+    detail::modify_tracked(
+        values,
+        [values](std::size_t first, std::size_t last) {
+            using element = Refined<T, Pred>;
+            detail::note_construction<element, construction::runtime_check>(
+                last - first);
+            for (std::size_t i = first; i < last; ++i) {
+                if (!Pred(values[i]))
+                    return false;
+            }
+            return true;
+        },
+        func);
+}
+
+// Whole-value modification for scalars and aggregates: func mutates a copy,
+// which is checked and committed only if it satisfies the predicate
+template <typename T, auto Pred, typename F>
+    requires(!incremental_predicate<Pred>) && std::invocable<F&, T&>
+constexpr void modify(Refined<T, Pred>& refined, F&& func) {
+    T value = refined.get();
+    std::invoke(func, value);
+    refined = Refined<T, Pred>(std::move(value), runtime_check);
+}
+
+} // namespace refinery
+
+#endif // REFINERY_MODIFY_HPP
@@ -10,8 +10,8 @@
 #include <optional>
 #include <type_traits>
 
+#include "core.hpp"
 #include "predicates.hpp"
-#include "refined_type.hpp"
 
 namespace refinery {
 
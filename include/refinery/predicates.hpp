@@ -4,9 +4,11 @@
 #ifndef REFINERY_PREDICATES_HPP
 #define REFINERY_PREDICATES_HPP
 
+#include <algorithm>
 #include <cmath>
 #include <concepts>
 #include <cstddef>
+#include <iterator>
 #include <limits>
 #include <string>
 #include <string_view>
@@ -105,27 +107,42 @@ inline constexpr auto Empty = [](const auto& v) constexpr {
 // True if container is not empty (Not<Empty>)
 inline constexpr auto NonEmpty = Not<Empty>;
 
+// Structural size-bound predicate: min_size <= v.size() <= max_size.
+// Public members make it a valid NTTP whose bounds can be read back at
+// compile time (e.g. to pick inline storage for size-bounded values).
+struct SizeBounds {
+    std::size_t min_size = 0;
+    std::size_t max_size = std::numeric_limits<std::size_t>::max();
+
+    constexpr bool operator()(const auto& v) const {
+        return v.size() >= min_size && v.size() <= max_size;
+    }
+};
+
 // True if container size >= min_size
 inline constexpr auto SizeAtLeast = [](std::size_t min_size) constexpr {
-    return [=](const auto& v) constexpr { return v.size() >= min_size; };
+    return SizeBounds{min_size, std::numeric_limits<std::size_t>::max()};
 };
 
 // True if container size <= max_size
 inline constexpr auto SizeAtMost = [](std::size_t max_size) constexpr {
-    return [=](const auto& v) constexpr { return v.size() <= max_size; };
+    return SizeBounds{0, max_size};
 };
 
 // True if container size == exact_size
 inline constexpr auto SizeExactly = [](std::size_t exact_size) constexpr {
-    return [=](const auto& v) constexpr { return v.size() == exact_size; };
+    return SizeBounds{exact_size, exact_size};
 };
 
 // True if container size is in [min_size, max_size]
 inline constexpr auto SizeInRange = [](std::size_t min_size,
                                        std::size_t max_size) constexpr {
-    return [=](const auto& v) constexpr {
-        return v.size() >= min_size && v.size() <= max_size;
-    };
+    return SizeBounds{min_size, max_size};
+};
+
+// True if elements are in non-descending order
+inline constexpr auto Sorted = [](const auto& v) constexpr {
+    return std::is_sorted(std::begin(v), std::end(v));
 };
 
 // --- Pointer predicates ---
@@ -0,0 +1,108 @@
+// refined_ref.hpp - Write-through proxy for elements of refined containers
+// Part of the C++26 Refinement Types Library
+//
+// RefinedRef<T, Pred> refers to a Refined<T, Pred> element. Assigning a raw T
+// validates it first and then writes in place; assigning a Refined<T, Pred>
+// writes without a check. The proxy is a single pointer and its members are
+// trivially inlinable; the failure path is kept out of line.
+
+#ifndef REFINERY_REFINED_REF_HPP
+#define REFINERY_REFINED_REF_HPP
+
+#include <type_traits>
+#include <utility>
+
+#include "core.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+template <typename T>
+[[noreturn, gnu::cold, gnu::noinline]] void
+throw_refinement_error(const T& value) {
+    throw refinement_error(value);
+}
+
+} // namespace detail
+
+template <typename T, auto Pred>
+    requires predicate_for<decltype(Pred), T>
+class RefinedRef {
+  public:
+    using value_type = T;
+    using refined_type = Refined<T, Pred>;
+
+  private:
+    refined_type* target_;
+
+  public:
+    constexpr explicit RefinedRef(refined_type& target) noexcept
+        : target_(&target) {}
+
+    constexpr RefinedRef(const RefinedRef&) noexcept = default;
+
+    // Validating write: throws refinement_error, leaving the target
+    // unchanged, if the value does not satisfy the predicate
+    constexpr RefinedRef& operator=(const T& value) {
+        detail::note_construction<refined_type, construction::runtime_check>();
+        if (!Pred(value)) [[unlikely]] {
+            detail::throw_refinement_error(value);
+        }
+        *target_ = refined_type(value, detail::adopt_checked);
+        return *this;
+    }
+
+    constexpr RefinedRef& operator=(T&& value) {
+        detail::note_construction<refined_type, construction::runtime_check>();
+        if (!Pred(value)) [[unlikely]] {
+            detail::throw_refinement_error(value);
+        }
+        *target_ = refined_type(std::move(value), detail::adopt_checked);
+        return *this;
+    }
+
+    // Unchecked write of an already refined value
+    constexpr RefinedRef& operator=(const refined_type& value) noexcept(
+        std::is_nothrow_copy_assignable_v<T>) {
+        *target_ = value;
+        return *this;
+    }
+
+    // Proxy semantics: assigns the referenced value, not the reference
+    constexpr RefinedRef& operator=(const RefinedRef& other) noexcept(
+        std::is_nothrow_copy_assignable_v<T>) {
+        *target_ = *other.target_;
+        return *this;
+    }
+
+    // Validating write that reports failure instead of throwing
+    [[nodiscard]] constexpr bool try_assign(const T& value) {
+        detail::note_construction<refined_type, construction::runtime_check>();
+        if (!Pred(value)) [[unlikely]] {
+            return false;
+        }
+        *target_ = refined_type(value, detail::adopt_checked);
+        return true;
+    }
+
+    // Access the referenced value
+    [[nodiscard]] constexpr const T& get() const noexcept {
+        return target_->get();
+    }
+    [[nodiscard]] constexpr const T& operator*() const noexcept {
+        return target_->get();
+    }
+    [[nodiscard]] constexpr const T* operator->() const noexcept {
+        return &target_->get();
+    }
+
+    // The referenced element
+    [[nodiscard]] constexpr operator const refined_type&() const noexcept {
+        return *target_;
+    }
+};
+
+} // namespace refinery
+
+#endif // REFINERY_REFINED_REF_HPP
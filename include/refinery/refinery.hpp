@@ -39,11 +39,13 @@
 #include <limits>
 
 #include "compose.hpp"
+#include "core.hpp"
 #include "diagnostics.hpp"
+#include "format.hpp"
 #include "interval.hpp"
 #include "operations.hpp"
 #include "predicates.hpp"
-#include "refined_type.hpp"
+#include "runtime_compose.hpp"
 
 namespace refinery {
 
@@ -0,0 +1,195 @@
+// registry.hpp - Named runtime predicates with lock-free lookup
+// Part of the C++26 Refinement Types Library
+//
+// runtime::PredicateRegistry<T> maps names to runtime predicates (lambdas,
+// runtime::AllOf/AnyOf/NoneOf, ...). Names are resolved once, at
+// registration or startup, to an interned predicate_id; the request path
+// then checks values by id with no lock and no string hashing. Predicates
+// can be replaced at any time: readers keep using the version they loaded
+// and the old one is reclaimed through epoch_domain::global().
+
+#ifndef REFINERY_REGISTRY_HPP
+#define REFINERY_REGISTRY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "compose.hpp"
+#include "core.hpp"
+#include "epoch.hpp"
+#include "runtime_compose.hpp"
+
+namespace refinery {
+
+namespace runtime {
+
+// Interned handle for a predicate registered in a PredicateRegistry
+struct predicate_id {
+    std::uint32_t index;
+
+    friend constexpr bool operator==(predicate_id, predicate_id) = default;
+};
+
+template <typename T> class PredicateRegistry {
+  public:
+    using value_type = T;
+    using predicate_type = std::function<bool(const T&)>;
+
+    PredicateRegistry() : table_(new table(16)) {}
+
+    PredicateRegistry(const PredicateRegistry&) = delete;
+    PredicateRegistry& operator=(const PredicateRegistry&) = delete;
+
+    // No check() may be running concurrently
+    ~PredicateRegistry() {
+        const table* t = table_.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < size_.load(); ++i) {
+            delete t->slots[i].load(std::memory_order_relaxed);
+        }
+        delete t;
+    }
+
+    // --- Registration (takes a lock; not for the request path)
+
+    // Register `pred` under `name`, replacing any predicate already
+    // registered under that name; returns the interned id for `name`
+    predicate_id register_predicate(std::string_view name,
+                                    predicate_type pred) {
+        std::lock_guard lock(mutex_);
+        if (auto it = ids_.find(std::string(name)); it != ids_.end()) {
+            swap_locked(it->second, std::move(pred));
+            return it->second;
+        }
+        const std::uint32_t index = size_.load(std::memory_order_relaxed);
+        table* t = reserve_locked(index + std::size_t{1});
+        t->slots[index].store(new entry{std::string(name), std::move(pred)},
+                              std::memory_order_release);
+        size_.store(index + 1, std::memory_order_release);
+        const predicate_id id{index};
+        ids_.emplace(std::string(name), id);
+        return id;
+    }
+
+    // Resolve a name to its id (startup / configuration time)
+    [[nodiscard]] std::optional<predicate_id>
+    find(std::string_view name) const {
+        std::lock_guard lock(mutex_);
+        if (auto it = ids_.find(std::string(name)); it != ids_.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    // Hot swap: checks already in progress finish with the old predicate,
+    // later checks see the new one; readers never wait
+    // Throws std::out_of_range if id was not issued by this registry
+    void replace(predicate_id id, predicate_type pred) {
+        std::lock_guard lock(mutex_);
+        check_id(id);
+        swap_locked(id, std::move(pred));
+    }
+
+    // --- Lookup (lock-free)
+
+    // Evaluate the predicate registered as `id` on `value`
+    // Throws std::out_of_range if id was not issued by this registry
+    [[nodiscard]] bool check(predicate_id id, const T& value) const {
+        auto pinned = epoch_domain::global().pin();
+        return load_entry(id).pred(value);
+    }
+
+    // Like check, but throws refinement_error naming the predicate if value
+    // is rejected
+    void validate(predicate_id id, const T& value) const {
+        auto pinned = epoch_domain::global().pin();
+        const entry& e = load_entry(id);
+        if (!e.pred(value)) {
+            throw refinement_error(value, e.name);
+        }
+    }
+
+    [[nodiscard]] std::string name(predicate_id id) const {
+        auto pinned = epoch_domain::global().pin();
+        return load_entry(id).name;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+  private:
+    struct entry {
+        std::string name;
+        predicate_type pred;
+    };
+
+    // Slot array; replaced (and the old one retired) when it fills up.
+    // Entries are shared between the old and new array.
+    struct table {
+        explicit table(std::size_t n)
+            : capacity(n),
+              slots(std::make_unique<std::atomic<const entry*>[]>(n)) {}
+
+        std::size_t capacity;
+        std::unique_ptr<std::atomic<const entry*>[]> slots;
+    };
+
+    void check_id(predicate_id id) const {
+        if (id.index >= size_.load(std::memory_order_acquire)) {
+            throw std::out_of_range("PredicateRegistry: unknown predicate id");
+        }
+    }
+
+    // Caller must be pinned
+    const entry& load_entry(predicate_id id) const {
+        check_id(id);
+        const table* t = table_.load(std::memory_order_acquire);
+        return *t->slots[id.index].load(std::memory_order_acquire);
+    }
+
+    void swap_locked(predicate_id id, predicate_type pred) {
+        table* t = table_.load(std::memory_order_relaxed);
+        const entry* old = t->slots[id.index].load(std::memory_order_relaxed);
+        t->slots[id.index].store(new entry{old->name, std::move(pred)},
+                                 std::memory_order_release);
+        epoch_domain::global().retire(old);
+    }
+
+    // Grow the slot array to hold at least n entries
+    table* reserve_locked(std::size_t n) {
+        table* t = table_.load(std::memory_order_relaxed);
+        if (n <= t->capacity) {
+            return t;
+        }
+        auto* bigger = new table(std::max(n, t->capacity * 2));
+        for (std::size_t i = 0; i < t->capacity; ++i) {
+            bigger->slots[i].store(t->slots[i].load(std::memory_order_relaxed),
+                                   std::memory_order_relaxed);
+        }
+        table_.store(bigger, std::memory_order_release);
+        epoch_domain::global().retire(static_cast<const table*>(t));
+        return bigger;
+    }
+
+    std::atomic<table*> table_;
+    std::atomic<std::uint32_t> size_{0};
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, predicate_id> ids_;
+};
+
+} // namespace runtime
+
+} // namespace refinery
+
+#endif // REFINERY_REGISTRY_HPP
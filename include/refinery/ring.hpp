@@ -0,0 +1,330 @@
+// ring.hpp - Lock-free ring buffers with power-of-two refined capacity
+// Part of the C++26 Refinement Types Library
+//
+// SpscRing<T> (single producer, single consumer) and MpmcRing<T> (multiple
+// producers and consumers) take their capacity as Refined<size_t, PowerOfTwo>.
+// Positions are free-running counters, and the slot for a position is
+// `position & (capacity - 1)`: the refinement guarantees that mask, so index
+// wrap is a single AND and slot access needs no bounds check or modulo.
+
+#ifndef REFINERY_RING_HPP
+#define REFINERY_RING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "atomic.hpp"
+#include "core.hpp"
+#include "predicates.hpp"
+
+namespace refinery {
+
+using RingCapacity = Refined<std::size_t, PowerOfTwo>;
+
+// Wait-free single-producer/single-consumer queue. Producer and consumer
+// each keep a cached copy of the other side's position, so the shared
+// counters are only read when the ring looks full (or empty).
+template <typename T> class SpscRing {
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    explicit SpscRing(RingCapacity capacity)
+        : mask_(capacity.get() - 1),
+          slots_(std::allocator<T>().allocate(capacity.get())) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    ~SpscRing() {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        for (size_type pos = head_.load(std::memory_order_relaxed);
+             pos != tail; ++pos) {
+            std::destroy_at(slot(pos));
+        }
+        std::allocator<T>().deallocate(slots_, capacity());
+    }
+
+    // --- Producer side (one thread)
+
+    template <typename... Args>
+        requires std::constructible_from<T, Args...>
+    [[nodiscard]] bool try_emplace(Args&&... args) {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        if (free_slots(tail) == 0) {
+            return false;
+        }
+        std::construct_at(slot(tail), std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] bool try_push(const T& value) { return try_emplace(value); }
+    [[nodiscard]] bool try_push(T&& value) {
+        return try_emplace(std::move(value));
+    }
+
+    // Push as many leading elements of `items` as fit and publish them with
+    // a single store; returns the number pushed
+    size_type try_push_n(std::span<const T> items) {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        const size_type n =
+            std::min(items.size(), free_slots(tail, items.size()));
+        size_type i = 0;
+        try {
+            for (; i < n; ++i) {
+                std::construct_at(slot(tail + i), items[i]);
+            }
+        } catch (...) {
+            tail_.store(tail + i, std::memory_order_release);
+            throw;
+        }
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // --- Consumer side (one thread)
+
+    [[nodiscard]] std::optional<T> try_pop() {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        if (ready_slots(head) == 0) {
+            return std::nullopt;
+        }
+        T* s = slot(head);
+        std::optional<T> value(std::move(*s));
+        std::destroy_at(s);
+        head_.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    // Move up to out.size() elements into `out` and release their slots
+    // with a single store; returns the number popped
+    size_type try_pop_n(std::span<T> out) {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        const size_type n = std::min(out.size(), ready_slots(head, out.size()));
+        size_type i = 0;
+        try {
+            for (; i < n; ++i) {
+                T* s = slot(head + i);
+                out[i] = std::move(*s);
+                std::destroy_at(s);
+            }
+        } catch (...) {
+            head_.store(head + i, std::memory_order_release);
+            throw;
+        }
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    // --- Observers (approximate while both sides are active)
+
+    [[nodiscard]] size_type capacity() const noexcept { return mask_ + 1; }
+    [[nodiscard]] size_type size() const noexcept {
+        // Head first: the tail loaded afterwards can only be further ahead
+        const size_type head = head_.load(std::memory_order_acquire);
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  private:
+    // In bounds for every position because capacity is a power of two
+    [[nodiscard]] T* slot(size_type position) const noexcept {
+        return slots_ + (position & mask_);
+    }
+
+    // Producer: free slots at `tail`; the cached head is refreshed only when
+    // it shows fewer than `wanted`
+    size_type free_slots(size_type tail, size_type wanted = 1) noexcept {
+        size_type free = capacity() - (tail - cached_head_);
+        if (free < wanted) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            free = capacity() - (tail - cached_head_);
+        }
+        return free;
+    }
+
+    // Consumer: filled slots at `head`; the cached tail is refreshed only when
+    // it shows fewer than `wanted`
+    size_type ready_slots(size_type head, size_type wanted = 1) noexcept {
+        size_type ready = cached_tail_ - head;
+        if (ready < wanted) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            ready = cached_tail_ - head;
+        }
+        return ready;
+    }
+
+    // Consumer-owned line
+    alignas(detail::cache_line_size) std::atomic<size_type> head_{0};
+    size_type cached_tail_ = 0;
+
+    // Producer-owned line
+    alignas(detail::cache_line_size) std::atomic<size_type> tail_{0};
+    size_type cached_head_ = 0;
+
+    // Read-only after construction
+    alignas(detail::cache_line_size) const size_type mask_;
+    T* const slots_;
+};
+
+// Lock-free multi-producer/multi-consumer queue (bounded, Vyukov-style).
+// Each slot carries a sequence number telling producers and consumers
+// whether it is free or filled for the current lap. Elements are built
+// before a slot is claimed, so a throwing constructor never leaves a
+// claimed slot unfilled; T must therefore be nothrow move constructible.
+template <typename T>
+    requires std::is_nothrow_move_constructible_v<T>
+class MpmcRing {
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    // Throws std::invalid_argument if capacity is 1 (sequence numbers need
+    // at least two slots to tell a full ring from an empty one)
+    explicit MpmcRing(RingCapacity capacity)
+        : mask_(checked_mask(capacity)),
+          cells_(std::make_unique<cell[]>(capacity.get())) {
+        for (size_type i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    ~MpmcRing() {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        for (size_type pos = head_.load(std::memory_order_relaxed);
+             pos != tail; ++pos) {
+            std::destroy_at(cell_at(pos).value());
+        }
+    }
+
+    template <typename... Args>
+        requires std::constructible_from<T, Args...>
+    [[nodiscard]] bool try_emplace(Args&&... args) {
+        T value(std::forward<Args>(args)...);
+        size_type pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell& c = cell_at(pos);
+            const size_type seq = c.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed)) {
+                    std::construct_at(c.value(), std::move(value));
+                    c.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    [[nodiscard]] bool try_push(const T& value) { return try_emplace(value); }
+    [[nodiscard]] bool try_push(T&& value) {
+        return try_emplace(std::move(value));
+    }
+
+    [[nodiscard]] std::optional<T> try_pop() {
+        size_type pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell& c = cell_at(pos);
+            const size_type seq = c.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed)) {
+                    std::optional<T> value(std::move(*c.value()));
+                    std::destroy_at(c.value());
+                    c.sequence.store(pos + mask_ + 1,
+                                     std::memory_order_release);
+                    return value;
+                }
+            } else if (diff < 0) {
+                return std::nullopt; // empty
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Push leading elements of `items` until the ring is full; returns the
+    // number pushed. Each element is claimed individually, so elements from
+    // concurrent producers may interleave.
+    size_type try_push_n(std::span<const T> items) {
+        size_type n = 0;
+        while (n < items.size() && try_push(items[n])) {
+            ++n;
+        }
+        return n;
+    }
+
+    // Pop into `out` until it is full or the ring is empty; returns the
+    // number popped
+    size_type try_pop_n(std::span<T> out) {
+        size_type n = 0;
+        for (; n < out.size(); ++n) {
+            auto value = try_pop();
+            if (!value) {
+                break;
+            }
+            out[n] = std::move(*value);
+        }
+        return n;
+    }
+
+    [[nodiscard]] size_type capacity() const noexcept { return mask_ + 1; }
+
+    // Approximate while producers or consumers are active
+    [[nodiscard]] size_type size() const noexcept {
+        const size_type head = head_.load(std::memory_order_acquire);
+        const size_type tail = tail_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  private:
+    struct cell {
+        std::atomic<size_type> sequence{0};
+        alignas(T) std::byte storage[sizeof(T)];
+
+        [[nodiscard]] T* value() noexcept {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    static size_type checked_mask(RingCapacity capacity) {
+        if (capacity.get() < 2) {
+            throw std::invalid_argument("MpmcRing: capacity must be >= 2");
+        }
+        return capacity.get() - 1;
+    }
+
+    // In bounds for every position because capacity is a power of two
+    [[nodiscard]] cell& cell_at(size_type position) const noexcept {
+        return cells_[position & mask_];
+    }
+
+    alignas(detail::cache_line_size) std::atomic<size_type> head_{0};
+    alignas(detail::cache_line_size) std::atomic<size_type> tail_{0};
+    alignas(detail::cache_line_size) const size_type mask_;
+    const std::unique_ptr<cell[]> cells_;
+};
+
+} // namespace refinery
+
+#endif // REFINERY_RING_HPP
@@ -0,0 +1,67 @@
+// runtime_compose.hpp - Runtime predicate composition
+// Part of the C++26 Refinement Types Library
+//
+// Type-erased counterparts of All/Any/Not for predicates chosen at run
+// time. Separate from compose.hpp because of <functional> and <vector>.
+
+#ifndef REFINERY_RUNTIME_COMPOSE_HPP
+#define REFINERY_RUNTIME_COMPOSE_HPP
+
+#include <functional>
+#include <vector>
+
+namespace refinery {
+
+// Runtime predicate composition (for dynamic predicates)
+namespace runtime {
+
+template <typename T> struct AllOf {
+    std::vector<std::function<bool(const T&)>> predicates;
+
+    template <typename... Preds>
+    explicit AllOf(Preds... preds) : predicates{preds...} {}
+
+    bool operator()(const T& v) const {
+        for (const auto& pred : predicates) {
+            if (!pred(v))
+                return false;
+        }
+        return true;
+    }
+};
+
+template <typename T> struct AnyOf {
+    std::vector<std::function<bool(const T&)>> predicates;
+
+    template <typename... Preds>
+    explicit AnyOf(Preds... preds) : predicates{preds...} {}
+
+    bool operator()(const T& v) const {
+        for (const auto& pred : predicates) {
+            if (pred(v))
+                return true;
+        }
+        return false;
+    }
+};
+
+template <typename T> struct NoneOf {
+    std::vector<std::function<bool(const T&)>> predicates;
+
+    template <typename... Preds>
+    explicit NoneOf(Preds... preds) : predicates{preds...} {}
+
+    bool operator()(const T& v) const {
+        for (const auto& pred : predicates) {
+            if (pred(v))
+                return false;
+        }
+        return true;
+    }
+};
+
+} // namespace runtime
+
+} // namespace refinery
+
+#endif // REFINERY_RUNTIME_COMPOSE_HPP
@@ -0,0 +1,127 @@
+// snapshot.hpp - Validate-once, read-many published snapshots
+// Part of the C++26 Refinement Types Library
+//
+// refined_snapshot<S, Pred> holds an immutable Refined<S, Pred>, typically a
+// configuration struct whose fields are themselves refined types. A writer
+// validates a complete new value once and publishes it with an atomic
+// pointer swap; readers pin the epoch, load the pointer and use the already
+// refined fields without re-checking or locking. Replaced snapshots are
+// reclaimed through epoch_domain::global() once no reader can see them.
+
+#ifndef REFINERY_SNAPSHOT_HPP
+#define REFINERY_SNAPSHOT_HPP
+
+#include <atomic>
+#include <concepts>
+#include <functional>
+#include <utility>
+
+#include "core.hpp"
+#include "epoch.hpp"
+#include "predicates.hpp"
+
+namespace refinery {
+
+template <typename S, auto Pred = Always>
+    requires predicate_for<decltype(Pred), S>
+class refined_snapshot {
+  public:
+    using value_type = S;
+    using refined_type = Refined<S, Pred>;
+
+    // Pinned view of the snapshot that was current when read() was called.
+    // The snapshot stays alive until the reader is destroyed; keep readers
+    // short-lived so replaced snapshots can be reclaimed.
+    class reader {
+      public:
+        reader(const reader&) = delete;
+        reader& operator=(const reader&) = delete;
+
+        [[nodiscard]] const S& operator*() const noexcept {
+            return value_->get();
+        }
+        [[nodiscard]] const S* operator->() const noexcept {
+            return &value_->get();
+        }
+        [[nodiscard]] const refined_type& refined() const noexcept {
+            return *value_;
+        }
+
+      private:
+        friend class refined_snapshot;
+
+        explicit reader(const std::atomic<const refined_type*>& current)
+            : guard_(epoch_domain::global()),
+              value_(current.load(std::memory_order_acquire)) {}
+
+        epoch_domain::guard guard_;
+        const refined_type* value_;
+    };
+
+    explicit refined_snapshot(refined_type initial)
+        : current_(new refined_type(std::move(initial))) {}
+
+    // Runtime checked construction
+    // Throws refinement_error if initial does not satisfy the predicate
+    refined_snapshot(S initial, runtime_check_t)
+        : refined_snapshot(refined_type(std::move(initial), runtime_check)) {}
+
+    refined_snapshot(const refined_snapshot&) = delete;
+    refined_snapshot& operator=(const refined_snapshot&) = delete;
+
+    // No reader may outlive the snapshot object itself
+    ~refined_snapshot() { delete current_.load(std::memory_order_acquire); }
+
+    // Wait-free after the thread's first pin: pins the epoch and loads the
+    // current snapshot. Throws std::bad_alloc if that first pin cannot
+    // allocate the thread's epoch record.
+    [[nodiscard]] reader read() const { return reader(current_); }
+
+    // Copy of the current snapshot
+    [[nodiscard]] refined_type load() const { return read().refined(); }
+
+    // Publish an already refined value
+    void publish(refined_type next) {
+        const refined_type* old = current_.exchange(
+            new refined_type(std::move(next)), std::memory_order_acq_rel);
+        epoch_domain::global().retire(old);
+    }
+
+    // Validate and publish
+    // Throws refinement_error (publishing nothing) if next does not satisfy
+    // the predicate
+    void publish(S next) {
+        publish(refined_type(std::move(next), runtime_check));
+    }
+
+    // Read-copy-update: apply func to a copy of the current value, validate
+    // the result and publish it. Retries if another writer published in the
+    // meantime, so func may run more than once. Throws refinement_error
+    // (publishing nothing) if the result does not satisfy the predicate.
+    template <typename F>
+        requires std::invocable<F&, S&>
+    void update(F func) {
+        auto pinned = epoch_domain::global().pin();
+        const refined_type* old = current_.load(std::memory_order_acquire);
+        for (;;) {
+            S copy = old->get();
+            std::invoke(func, copy);
+            const auto* next =
+                new refined_type(std::move(copy), runtime_check);
+            if (current_.compare_exchange_strong(old, next,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+                epoch_domain::global().retire(old);
+                return;
+            }
+            delete next;
+        }
+    }
+
+  private:
+    std::atomic<const refined_type*> current_;
+};
+
+} // namespace refinery
+
+#endif // REFINERY_SNAPSHOT_HPP
@@ -0,0 +1,115 @@
+// static_data.hpp - Compile-time refinement of constant tables
+// Part of the C++26 Refinement Types Library
+//
+// refine_array<Pred>(std::array<T, N>) and refine_bytes<T, Pred>(blob) turn
+// constant data -- literal tables or byte blobs pulled in with #embed -- into
+// a std::array<Refined<T, Pred>, N> during constant evaluation, so nothing
+// is validated at startup. The whole table is checked in one pass (reporting
+// the first offending index) and the elements are then wrapped without
+// re-evaluating the predicate, instead of N consteval Refined constructions.
+//
+//   constexpr unsigned char blob[] = {
+//   #embed "ports.bin"
+//   };
+//   constexpr auto ports = refine_bytes<std::uint16_t, Positive>(blob);
+
+#ifndef REFINERY_STATIC_DATA_HPP
+#define REFINERY_STATIC_DATA_HPP
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <meta>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "bulk.hpp"
+#include "core.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+template <typename B>
+concept byte_like = sizeof(B) == 1 && (std::integral<B> ||
+                                       std::same_as<std::remove_cv_t<B>,
+                                                    std::byte>);
+
+// Compile-time error for the first element of a table that fails Pred
+template <typename T, auto Pred>
+consteval void table_violation(std::size_t index, const T& value) {
+    using namespace std::meta;
+    std::string msg = "Refinement violation: element ";
+    msg += display_string_of(reflect_constant(index));
+    msg += " (";
+    msg += display_string_of(reflect_constant(value));
+    msg += ") does not satisfy predicate";
+    throw std::meta::exception(msg, ^^Refined<T, Pred>);
+}
+
+// Wrap already-checked values without evaluating the predicate again
+template <auto Pred, typename T, std::size_t N, std::size_t... I>
+consteval std::array<Refined<T, Pred>, N>
+wrap_checked(const std::array<T, N>& values, std::index_sequence<I...>) {
+    note_construction<Refined<T, Pred>, construction::compile_time>();
+    return {Refined<T, Pred>(values[I], adopt_checked)...};
+}
+
+// Decode N values of T (native byte order) from the bytes at `bytes`
+template <typename T, std::size_t N, typename B>
+consteval std::array<T, N> parse_bytes(const B* bytes) {
+    std::array<T, N> values{};
+    for (std::size_t i = 0; i < N; ++i) {
+        std::array<unsigned char, sizeof(T)> raw{};
+        for (std::size_t b = 0; b < sizeof(T); ++b) {
+            raw[b] = static_cast<unsigned char>(bytes[i * sizeof(T) + b]);
+        }
+        values[i] = std::bit_cast<T>(raw);
+    }
+    return values;
+}
+
+} // namespace detail
+
+// Verify Pred for every element of `values` and return them as refined
+// values. Fails to compile, naming the first offending index, otherwise.
+template <auto Pred, typename T, std::size_t N>
+    requires predicate_for<decltype(Pred), T>
+consteval std::array<Refined<T, Pred>, N>
+refine_array(const std::array<T, N>& values) {
+    const std::size_t bad =
+        detail::find_invalid<Pred>(std::span<const T>(values));
+    if (bad != N) {
+        detail::table_violation<T, Pred>(bad, values[bad]);
+    }
+    return detail::wrap_checked<Pred>(values, std::make_index_sequence<N>{});
+}
+
+// Reinterpret a byte blob (e.g. from #embed) as N = Bytes / sizeof(T)
+// values of T in native byte order, then refine them like refine_array
+template <typename T, auto Pred, detail::byte_like B, std::size_t Bytes>
+    requires predicate_for<decltype(Pred), T> &&
+             std::is_trivially_copyable_v<T>
+consteval auto refine_bytes(const B (&bytes)[Bytes]) {
+    static_assert(Bytes % sizeof(T) == 0,
+                  "blob size must be a multiple of sizeof(T)");
+    return refine_array<Pred>(
+        detail::parse_bytes<T, Bytes / sizeof(T)>(bytes));
+}
+
+template <typename T, auto Pred, detail::byte_like B, std::size_t Bytes>
+    requires predicate_for<decltype(Pred), T> &&
+             std::is_trivially_copyable_v<T>
+consteval auto refine_bytes(const std::array<B, Bytes>& bytes) {
+    static_assert(Bytes % sizeof(T) == 0,
+                  "blob size must be a multiple of sizeof(T)");
+    return refine_array<Pred>(
+        detail::parse_bytes<T, Bytes / sizeof(T)>(bytes.data()));
+}
+
+} // namespace refinery
+
+#endif // REFINERY_STATIC_DATA_HPP
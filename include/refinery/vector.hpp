@@ -0,0 +1,344 @@
+// vector.hpp - Vector of refined elements with validated mutation
+// Part of the C++26 Refinement Types Library
+//
+// RefinedVector<T, Pred> maintains the invariant "every element satisfies
+// Pred" like Refined<std::vector<T>, AllElements<Pred>>, but mutations only
+// validate the elements they add instead of re-checking the whole vector.
+//
+// The elements are stored as Refined<T, Pred>, so refined() and iteration
+// hand out real refined objects. The Allocator parameter (rebound to
+// Refined<T, Pred>) lets them live in caller-provided storage;
+// pmr::RefinedVector uses std::pmr::polymorphic_allocator so a validated
+// object graph can be built in (and released with) a monotonic arena.
+
+#ifndef REFINERY_VECTOR_HPP
+#define REFINERY_VECTOR_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bulk.hpp"
+#include "compose.hpp"
+#include "core.hpp"
+#include "refined_ref.hpp"
+
+namespace refinery {
+
+namespace detail {
+
+// Mutable access to the values of a RefinedVector, for modify
+struct refined_vector_access;
+
+} // namespace detail
+
+template <typename T, auto Pred, typename Allocator = std::allocator<T>>
+    requires predicate_for<decltype(Pred), T>
+class RefinedVector {
+  public:
+    using value_type = T;
+    using refined_type = Refined<T, Pred>;
+    using allocator_type = Allocator;
+    using container_type = std::vector<T, Allocator>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_iterator = const refined_type*;
+    using iterator = const_iterator;
+    static constexpr auto predicate = Pred;
+
+  private:
+    friend struct detail::refined_vector_access;
+
+    // Refined is a standard-layout class whose only member is its T, so each
+    // element is pointer-interconvertible with its value and the values are
+    // laid out like an array of T; values() views them through that member.
+    static_assert(sizeof(refined_type) == sizeof(T) &&
+                  alignof(refined_type) == alignof(T) &&
+                  std::is_standard_layout_v<refined_type>);
+
+    using refined_allocator = typename std::allocator_traits<
+        Allocator>::template rebind_alloc<refined_type>;
+    using storage_type = std::vector<refined_type, refined_allocator>;
+
+    storage_type elements_;
+
+    static void check(const T& value) {
+        detail::note_construction<refined_type, construction::runtime_check>();
+        if (!Pred(value)) {
+            throw refinement_error(value);
+        }
+    }
+
+    static void check_all(std::span<const T> values) {
+        detail::note_construction<refined_type, construction::runtime_check>(
+            values.size());
+        const auto bad = detail::find_invalid<Pred>(values);
+        if (bad != values.size()) {
+            throw refinement_error(values[bad]);
+        }
+    }
+
+    // Wrap values whose check has already been recorded
+    static auto adopted(std::span<const T> values) {
+        return values | std::views::transform([](const T& value) {
+                   return refined_type(value, detail::adopt_checked);
+               });
+    }
+
+    static auto adopted(container_type& values) {
+        return values | std::views::transform([](T& value) {
+                   return refined_type(std::move(value), detail::adopt_checked);
+               });
+    }
+
+    // Mutable values, for modify; see values()
+    [[nodiscard]] T* data() noexcept {
+        return reinterpret_cast<T*>(elements_.data());
+    }
+
+    [[nodiscard]] auto to_raw(const_iterator pos) const noexcept {
+        return elements_.begin() + (pos - begin());
+    }
+
+    [[nodiscard]] iterator
+    from_raw(typename storage_type::const_iterator it) const noexcept {
+        return begin() + (it - elements_.begin());
+    }
+
+  public:
+    RefinedVector() = default;
+
+    // Empty vector allocating from `alloc`
+    explicit RefinedVector(const Allocator& alloc) noexcept
+        : elements_(refined_allocator(alloc)) {}
+
+    // Allocator-extended copy and move (uses-allocator construction)
+    RefinedVector(const RefinedVector& other, const Allocator& alloc)
+        : elements_(other.elements_, refined_allocator(alloc)) {}
+    RefinedVector(RefinedVector&& other, const Allocator& alloc)
+        : elements_(std::move(other.elements_), refined_allocator(alloc)) {}
+
+    RefinedVector(const RefinedVector&) = default;
+    RefinedVector(RefinedVector&&) noexcept = default;
+    RefinedVector& operator=(const RefinedVector&) = default;
+    RefinedVector& operator=(RefinedVector&&) = default;
+
+    // Runtime checked construction
+    // Throws refinement_error if any element does not satisfy the predicate
+    RefinedVector(container_type values, runtime_check_t)
+        : elements_(refined_allocator(values.get_allocator())) {
+        check_all(values);
+        elements_.append_range(adopted(values));
+    }
+
+    // Unchecked construction (for trusted contexts)
+    // WARNING: Caller is responsible for every element satisfying Pred
+    RefinedVector(container_type values, assume_valid_t)
+        : elements_(refined_allocator(values.get_allocator())) {
+        elements_.append_range(adopted(values));
+    }
+
+    // Converting construction from the whole-container refinement
+    explicit RefinedVector(Refined<container_type, AllElements<Pred>> values)
+        : RefinedVector(std::move(values).release(), assume_valid) {}
+
+    // Replace the contents; validated in bulk before anything is modified
+    void assign(std::span<const T> values) {
+        check_all(values);
+        elements_.assign_range(adopted(values));
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept {
+        return allocator_type(elements_.get_allocator());
+    }
+
+    // --- Element access
+
+    [[nodiscard]] const refined_type& operator[](size_type i) const noexcept {
+        return elements_[i];
+    }
+
+    // Write-through proxy: assigning a raw T validates it first
+    [[nodiscard]] RefinedRef<T, Pred> operator[](size_type i) noexcept {
+        return RefinedRef<T, Pred>(elements_[i]);
+    }
+
+    [[nodiscard]] const refined_type& at(size_type i) const {
+        if (i >= elements_.size()) {
+            throw std::out_of_range("RefinedVector::at");
+        }
+        return elements_[i];
+    }
+
+    [[nodiscard]] const refined_type& front() const noexcept {
+        return elements_.front();
+    }
+    [[nodiscard]] const refined_type& back() const noexcept {
+        return elements_.back();
+    }
+
+    // Views over the same storage, free of any copy or check
+    [[nodiscard]] std::span<const refined_type> refined() const noexcept {
+        return elements_;
+    }
+    [[nodiscard]] std::span<const T> values() const noexcept {
+        return {reinterpret_cast<const T*>(elements_.data()), elements_.size()};
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return elements_.data();
+    }
+    [[nodiscard]] const_iterator end() const noexcept {
+        return elements_.data() + elements_.size();
+    }
+
+    // --- Capacity
+
+    [[nodiscard]] size_type size() const noexcept { return elements_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return elements_.empty(); }
+    [[nodiscard]] size_type capacity() const noexcept {
+        return elements_.capacity();
+    }
+    void reserve(size_type n) { elements_.reserve(n); }
+    void shrink_to_fit() { elements_.shrink_to_fit(); }
+
+    // --- Modifiers: only newly added elements are validated
+
+    void push_back(const T& value) {
+        check(value);
+        elements_.emplace_back(value, detail::adopt_checked);
+    }
+
+    void push_back(T&& value) {
+        check(value);
+        elements_.emplace_back(std::move(value), detail::adopt_checked);
+    }
+
+    void push_back(const refined_type& value) { elements_.push_back(value); }
+
+    // Construct in place, then validate; nothing is added if the element
+    // does not satisfy the predicate
+    template <typename... Args>
+        requires std::constructible_from<T, Args...>
+    const refined_type& emplace_back(Args&&... args) {
+        return elements_.emplace_back(std::in_place,
+                                      std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+        requires std::constructible_from<T, Args...>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        return from_raw(elements_.emplace(to_raw(pos), std::in_place,
+                                          std::forward<Args>(args)...));
+    }
+
+    iterator insert(const_iterator pos, const T& value) {
+        check(value);
+        return from_raw(elements_.insert(
+            to_raw(pos), refined_type(value, detail::adopt_checked)));
+    }
+
+    iterator insert(const_iterator pos, T&& value) {
+        check(value);
+        return from_raw(elements_.insert(
+            to_raw(pos), refined_type(std::move(value), detail::adopt_checked)));
+    }
+
+    iterator insert(const_iterator pos, const refined_type& value) {
+        return from_raw(elements_.insert(to_raw(pos), value));
+    }
+
+    // Overwrite [first, first + values.size()) in place, validated in bulk
+    // before anything is written
+    void assign_range(size_type first, std::span<const T> values) {
+        if (first > elements_.size() ||
+            values.size() > elements_.size() - first) {
+            throw std::out_of_range("RefinedVector::assign_range");
+        }
+        check_all(values);
+        std::ranges::copy(adopted(values), elements_.begin() + first);
+    }
+
+    // Insert a batch, validated in bulk before anything is modified
+    iterator insert(const_iterator pos, std::span<const T> values) {
+        check_all(values);
+        return from_raw(elements_.insert_range(to_raw(pos), adopted(values)));
+    }
+
+    // Append the elements of `values` that satisfy Pred and skip the rest,
+    // evaluating the predicate in bulk blocks; returns the number appended
+    size_type append_valid(std::span<const T> values) {
+        std::uint8_t bitmap[detail::bitmap_bytes(detail::bulk_block)];
+        size_type appended = 0;
+        for (size_type first = 0; first < values.size();
+             first += detail::bulk_block) {
+            const auto block = values.subspan(
+                first, std::min(detail::bulk_block, values.size() - first));
+            std::fill(std::begin(bitmap), std::end(bitmap), std::uint8_t{0});
+            appended += detail::evaluate_bitmap<Pred>(block, bitmap);
+            for (size_type i = 0; i < block.size(); ++i) {
+                if ((bitmap[i / 8] >> (i % 8)) & 1u) {
+                    elements_.emplace_back(block[i], detail::adopt_checked);
+                }
+            }
+        }
+        return appended;
+    }
+
+    // Removing elements cannot violate a per-element predicate
+    iterator erase(const_iterator pos) {
+        return from_raw(elements_.erase(to_raw(pos)));
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        return from_raw(elements_.erase(to_raw(first), to_raw(last)));
+    }
+
+    void pop_back() { elements_.pop_back(); }
+    void clear() noexcept { elements_.clear(); }
+
+    // Explicit conversion to the raw vector (allows modification outside the
+    // wrapper); each value is moved out of its element
+    [[nodiscard]] container_type release() && {
+        container_type values(get_allocator());
+        values.append_range(
+            elements_ | std::views::transform([](refined_type& element) {
+                return std::move(element).release();
+            }));
+        elements_.clear();
+        return values;
+    }
+
+    // Convert to the equivalent whole-container refinement without re-checking
+    [[nodiscard]] Refined<container_type, AllElements<Pred>> to_refined() && {
+        return Refined<container_type, AllElements<Pred>>(
+            std::move(*this).release(), assume_valid);
+    }
+
+    [[nodiscard]] friend bool operator==(const RefinedVector& lhs,
+                                         const RefinedVector& rhs) {
+        return lhs.elements_ == rhs.elements_;
+    }
+};
+
+namespace pmr {
+
+// RefinedVector whose elements are allocated from a std::pmr::memory_resource
+template <typename T, auto Pred>
+using RefinedVector =
+    refinery::RefinedVector<T, Pred, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
+} // namespace refinery
+
+#endif // REFINERY_VECTOR_HPP
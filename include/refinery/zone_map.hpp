@@ -0,0 +1,240 @@
+// zone_map.hpp - Per-block min/max metadata for raw and refined columns
+// Part of the C++26 Refinement Types Library
+//
+// A ZoneMap records the minimum and maximum of every fixed-size block of a
+// column. Checking a block against an Interval then needs two comparisons:
+// blocks entirely inside the interval are accepted wholesale, blocks entirely
+// outside are skipped, and only straddling blocks are evaluated row by row.
+
+#ifndef REFINERY_ZONE_MAP_HPP
+#define REFINERY_ZONE_MAP_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "bulk.hpp"
+#include "column.hpp"
+#include "core.hpp"
+#include "interval.hpp"
+
+namespace refinery {
+
+// How a block relates to a target interval
+enum class zone_match {
+    none,    // no row in the block can satisfy the interval
+    partial, // rows must be checked individually
+    all,     // every row in the block satisfies the interval
+};
+
+template <typename T, std::size_t BlockSize = 4096>
+    requires std::totally_ordered<T>
+class ZoneMap {
+  public:
+    static constexpr std::size_t block_size = BlockSize;
+
+    struct zone {
+        T min{};
+        T max{};
+        std::size_t count = 0;  // rows summarized (valid rows for columns)
+        bool unordered = false; // block contains NaN
+    };
+
+    ZoneMap() = default;
+
+    // Summarize every row of a raw column
+    explicit ZoneMap(std::span<const T> values) : size_(values.size()) {
+        zones_.reserve((values.size() + BlockSize - 1) / BlockSize);
+        for (std::size_t first = 0; first < values.size();
+             first += BlockSize) {
+            const auto block =
+                values.subspan(first, std::min(BlockSize, size_ - first));
+            zones_.push_back(summarize(block));
+        }
+    }
+
+    // Summarize only the valid rows of a refined column
+    template <auto Pred>
+    explicit ZoneMap(const RefinedColumn<T, Pred>& column)
+        : size_(column.size()) {
+        const auto values = column.values();
+        zones_.reserve((values.size() + BlockSize - 1) / BlockSize);
+        for (std::size_t first = 0; first < values.size();
+             first += BlockSize) {
+            const std::size_t last = std::min(first + BlockSize, size_);
+            zone z;
+            bool seeded = false;
+            for (std::size_t row = first; row < last; ++row) {
+                if (!column.is_valid(row)) {
+                    continue;
+                }
+                const T& v = values[row];
+                ++z.count;
+                if constexpr (std::floating_point<T>) {
+                    if (v != v) {
+                        z.unordered = true;
+                        continue;
+                    }
+                }
+                if (!seeded) {
+                    z.min = v;
+                    z.max = v;
+                    seeded = true;
+                } else {
+                    z.min = v < z.min ? v : z.min;
+                    z.max = v > z.max ? v : z.max;
+                }
+            }
+            zones_.push_back(z);
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] std::size_t block_count() const noexcept {
+        return zones_.size();
+    }
+    [[nodiscard]] std::span<const zone> zones() const noexcept {
+        return zones_;
+    }
+
+    // Classify block `block` against the interval [Target.lo, Target.hi]
+    template <auto Target>
+        requires interval_predicate<Target>
+    [[nodiscard]] zone_match match(std::size_t block) const noexcept {
+        const zone& z = zones_[block];
+        if (z.count == 0) {
+            return zone_match::none;
+        }
+        if (z.unordered) {
+            return zone_match::partial;
+        }
+        if (z.max < Target.lo || z.min > Target.hi) {
+            return zone_match::none;
+        }
+        if (z.min >= Target.lo && z.max <= Target.hi) {
+            return zone_match::all;
+        }
+        return zone_match::partial;
+    }
+
+  private:
+    static constexpr zone summarize(std::span<const T> block) {
+        zone z;
+        z.count = block.size();
+        if (block.empty()) {
+            return z;
+        }
+        // Branch-free min/max so the loop vectorizes
+        T lo = block[0];
+        T hi = block[0];
+        bool unordered = false;
+        for (const T& v : block) {
+            lo = v < lo ? v : lo;
+            hi = v > hi ? v : hi;
+            if constexpr (std::floating_point<T>) {
+                unordered |= (v != v);
+            }
+        }
+        z.min = lo;
+        z.max = hi;
+        z.unordered = unordered;
+        return z;
+    }
+
+    std::vector<zone> zones_;
+    std::size_t size_ = 0;
+};
+
+// Re-validate a refined column against a tighter interval. Blocks accepted or
+// rejected by the zone map are handled without touching their values; when
+// Pred already implies Target, the existing bitmap is reused as-is.
+// `zones` must summarize `column`.
+template <auto Target, typename T, auto Pred, std::size_t BlockSize>
+    requires interval_predicate<Target>
+[[nodiscard]] RefinedColumn<T, Target>
+revalidate(RefinedColumn<T, Pred> column,
+           const ZoneMap<T, BlockSize>& zones) {
+    static_assert(BlockSize % 8 == 0, "zone blocks must be byte-aligned");
+
+    std::vector<std::uint8_t> bitmap(column.validity_bitmap().begin(),
+                                     column.validity_bitmap().end());
+    if constexpr (!detail::predicate_implies<T, Pred, Target>()) {
+        const auto values = column.values();
+        for (std::size_t b = 0; b < zones.block_count(); ++b) {
+            const std::size_t first = b * BlockSize;
+            const std::size_t last = std::min(first + BlockSize, values.size());
+            const std::size_t first_byte = first / 8;
+            const std::size_t last_byte = detail::bitmap_bytes(last);
+
+            switch (zones.template match<Target>(b)) {
+            case zone_match::all:
+                break;
+            case zone_match::none:
+                std::fill(bitmap.begin() + first_byte,
+                          bitmap.begin() + last_byte, std::uint8_t{0});
+                break;
+            case zone_match::partial: {
+                std::vector<std::uint8_t> target(last_byte - first_byte, 0);
+                detail::evaluate_bitmap<Target>(
+                    values.subspan(first, last - first), target.data());
+                for (std::size_t i = 0; i < target.size(); ++i) {
+                    bitmap[first_byte + i] &= target[i];
+                }
+                break;
+            }
+            }
+        }
+    }
+    return RefinedColumn<T, Target>(std::move(column).release(),
+                                    std::move(bitmap), assume_valid);
+}
+
+// Row indices of `values` that fall inside Target, skipping blocks the zone
+// map proves empty and emitting accepted blocks without per-row checks.
+template <auto Target, typename T, std::size_t BlockSize>
+    requires interval_predicate<Target>
+[[nodiscard]] std::vector<std::size_t>
+select_rows(std::span<const T> values, const ZoneMap<T, BlockSize>& zones) {
+    std::vector<std::size_t> rows;
+    for (std::size_t b = 0; b < zones.block_count(); ++b) {
+        const std::size_t first = b * BlockSize;
+        const std::size_t last = std::min(first + BlockSize, values.size());
+        switch (zones.template match<Target>(b)) {
+        case zone_match::none:
+            break;
+        case zone_match::all:
+            for (std::size_t row = first; row < last; ++row) {
+                rows.push_back(row);
+            }
+            break;
+        case zone_match::partial:
+            for (std::size_t row = first; row < last; ++row) {
+                if (Target(values[row])) {
+                    rows.push_back(row);
+                }
+            }
+            break;
+        }
+    }
+    return rows;
+}
+
+// Valid rows of a refined column that fall inside Target
+template <auto Target, typename T, auto Pred, std::size_t BlockSize>
+    requires interval_predicate<Target>
+[[nodiscard]] std::vector<std::size_t>
+select_rows(const RefinedColumn<T, Pred>& column,
+            const ZoneMap<T, BlockSize>& zones) {
+    auto rows = select_rows<Target>(column.values(), zones);
+    std::erase_if(rows,
+                  [&](std::size_t row) { return !column.is_valid(row); });
+    return rows;
+}
+
+} // namespace refinery
+
+#endif // REFINERY_ZONE_MAP_HPP
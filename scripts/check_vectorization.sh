@@ -0,0 +1,153 @@
+#!/usr/bin/env bash
+# check_vectorization.sh — Check refined_* loops vectorize like their plain_* twins
+#
+# Usage: check_vectorization.sh <build-examples-dir> <source-dir> <prefix> <example-names...>
+# Example: check_vectorization.sh build/examples examples/vectorization vectorization_ 01_sum
+#
+# Each example must be compiled with -fopt-info-vec-optimized=<prefix><example>.vec
+# into <build-examples-dir>. For every refined_*/plain_* pair the script takes
+#   - the widest "loop vectorized using N byte vectors" remark that GCC
+#     reports inside the function's source lines, and
+#   - the widest vector register used by packed instructions in the
+#     function's disassembly (xmm 16, ymm 32, zmm 64; scalar FP, register
+#     moves and zeroing idioms are ignored),
+# and requires both to match between the pair, with the plain loop
+# vectorized at all.
+
+set -euo pipefail
+
+BUILD_DIR="$1"
+SRC_DIR="$2"
+PREFIX="$3"
+shift 3
+EXAMPLES=("$@")
+
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+YELLOW='\033[1;33m'
+BOLD='\033[1m'
+RESET='\033[0m'
+
+PASS=0
+FAIL=0
+TOTAL=0
+
+DUMPFILE=$(mktemp)
+trap 'rm -f "$DUMPFILE"' EXIT
+
+# Instructions of a function (hot part only), without addresses or comments
+function_body() {
+    local header
+    header=$(grep -n "^[0-9a-f]* <$1(" "$DUMPFILE" | grep -v '\[clone \.cold\]' | head -1 | cut -d: -f1)
+    [[ -n "$header" ]] || return 1
+    tail -n +"$((header + 1))" "$DUMPFILE" \
+        | sed '/^$/q' \
+        | grep -v '^$' \
+        | sed 's/^[[:space:]]*[0-9a-f]*:[[:space:]]*//' \
+        | sed 's/#.*$//' \
+        || true
+}
+
+# Widest vector register (bytes) used by a packed instruction; 0 if none
+packed_width() {
+    awk '
+        {
+            m = $1; ops = $2; sub(/^v/, "", m)
+            if (ops !~ /%[xyz]mm/) next
+            # GPR <-> vector transfers and scalar FP (addsd, movss, ...)
+            if (m ~ /^mov[dq]$/ || m ~ /^cvt/ || (m !~ /^p/ && m ~ /s[sd]$/)) next
+            # Register-to-register moves and zeroing idioms
+            if (m ~ /^mov(ap[sd]|dq[au]|up[sd])$/ && ops ~ /^%[xyz]mm[0-9]+,%[xyz]mm[0-9]+$/) next
+            if (m ~ /^(p?xor|xorp[sd])$/) {
+                n = split(ops, r, ",")
+                if (r[1] == r[n]) next
+            }
+            if (m !~ /^p/ && m !~ /p[sd]$/ && m !~ /^(movdq|shuf|unpck|blend)/) next
+            w = ops ~ /%zmm/ ? 64 : ops ~ /%ymm/ ? 32 : 16
+            if (w > best) best = w
+        }
+        END { print best + 0 }
+    '
+}
+
+# First source line of each refined_*/plain_* function, as "line name"
+function_starts() {
+    grep -noE '\b(refined|plain)_[A-Za-z0-9_]+\(' "$1" \
+        | sed 's/($//' \
+        | awk -F: '!seen[$2]++ { print $1, $2 }'
+}
+
+# Widest "loop vectorized using N byte vectors" remark inside a function's
+# source lines; $1 = source, $2 = remarks file, $3 = function
+remark_width() {
+    local src="$1" remarks="$2" func="$3" first last
+    first=$(function_starts "$src" | awk -v f="$func" '$2 == f { print $1 }')
+    last=$(function_starts "$src" | sort -n \
+        | awk -v s="$first" '$1 > s { print $1 - 1; exit }')
+    [[ -n "$last" ]] || last=999999
+    awk -v file="$(basename "$src")" -v lo="$first" -v hi="$last" '
+        match($0, /[^:\/]+\.cpp:[0-9]+:/) {
+            split(substr($0, RSTART, RLENGTH - 1), loc, ":")
+            if (loc[1] != file || loc[2] < lo || loc[2] > hi) next
+            if (match($0, /loop vectorized using [0-9]+ byte vectors/)) {
+                split(substr($0, RSTART, RLENGTH), words, " ")
+                if (words[4] > best) best = words[4]
+            }
+        }
+        END { print best + 0 }
+    ' "$remarks"
+}
+
+for example in "${EXAMPLES[@]}"; do
+    binary="${BUILD_DIR}/${PREFIX}${example}"
+    remarks="${BUILD_DIR}/${PREFIX}${example}.vec"
+    source="${SRC_DIR}/${example}.cpp"
+
+    if [[ ! -f "$binary" || ! -f "$remarks" ]]; then
+        echo -e "${RED}SKIP${RESET} ${example}: ${binary} or ${remarks} not found"
+        continue
+    fi
+
+    objdump -d --no-show-raw-insn "$binary" | c++filt > "$DUMPFILE"
+
+    REFINED_FUNCS=$(function_starts "$source" | awk '$2 ~ /^refined_/ { print $2 }')
+    if [[ -z "$REFINED_FUNCS" ]]; then
+        echo -e "${YELLOW}SKIP${RESET} ${example}: no refined_* functions found"
+        continue
+    fi
+
+    for refined_func in $REFINED_FUNCS; do
+        plain_func="${refined_func/refined_/plain_}"
+        TOTAL=$((TOTAL + 1))
+
+        if ! refined_asm=$(function_body "$refined_func") || ! plain_asm=$(function_body "$plain_func"); then
+            echo -e "${RED}MISS${RESET} ${example}: ${refined_func} or ${plain_func} not found in disassembly"
+            FAIL=$((FAIL + 1))
+            continue
+        fi
+
+        refined_remark=$(remark_width "$source" "$remarks" "$refined_func")
+        plain_remark=$(remark_width "$source" "$remarks" "$plain_func")
+        refined_simd=$(packed_width <<< "$refined_asm")
+        plain_simd=$(packed_width <<< "$plain_asm")
+        detail="opt-info ${refined_remark}/${plain_remark} bytes, packed ops ${refined_simd}/${plain_simd} bytes"
+
+        if [[ "$plain_remark" -eq 0 ]]; then
+            echo -e "${YELLOW}NOVEC${RESET} ${example}: ${plain_func} is not vectorized (${detail})"
+            FAIL=$((FAIL + 1))
+        elif [[ "$refined_remark" -eq "$plain_remark" && "$refined_simd" -eq "$plain_simd" ]]; then
+            echo -e "${GREEN}PASS${RESET} ${example}: ${refined_func} vectorized like ${plain_func} (${detail})"
+            PASS=$((PASS + 1))
+        else
+            echo -e "${RED}FAIL${RESET} ${example}: ${refined_func} vectorized differently from ${plain_func} (${detail})"
+            FAIL=$((FAIL + 1))
+        fi
+    done
+done
+
+echo ""
+echo -e "${BOLD}Results: ${GREEN}${PASS} passed${RESET}, ${RED}${FAIL} failed${RESET} (${TOTAL} total)"
+
+if [[ $FAIL -gt 0 ]]; then
+    exit 1
+fi
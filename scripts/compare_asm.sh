@@ -1,16 +1,31 @@
 #!/usr/bin/env bash
 # compare_asm.sh — Compare assembly of refined_* vs plain_* function pairs
 #
-# Usage: compare_asm.sh <build-examples-dir> <prefix> <example-names...>
+# Usage: compare_asm.sh [--report FILE] <build-examples-dir> <prefix> <example-names...>
 # Example: compare_asm.sh build/examples zero_overhead_ 01_value_passthrough 02_arithmetic
+#
+# --report FILE writes a JSON cost table with one entry per pair, keyed
+# "<example>/<refined function>": status, hot-path instruction and branch
+# counts (cold clones excluded) for both functions, their deltas
+# (refined - plain), and the llvm-mca block reciprocal throughput when
+# llvm-mca is found (LLVM_MCA overrides the path, LLVM_MCA_CPU sets -mcpu;
+# otherwise the rthroughput fields are null).
 
 set -euo pipefail
 
+REPORT=""
+if [[ "${1:-}" == "--report" ]]; then
+    REPORT="$2"
+    shift 2
+fi
+
 BUILD_DIR="$1"
 PREFIX="$2"
 shift 2
 EXAMPLES=("$@")
 
+LLVM_MCA="${LLVM_MCA:-$(command -v llvm-mca || true)}"
+
 RED='\033[0;31m'
 GREEN='\033[0;32m'
 YELLOW='\033[1;33m'
@@ -24,6 +39,8 @@ TOTAL=0
 DUMPFILE=$(mktemp)
 trap 'rm -f "$DUMPFILE"' EXIT
 
+REPORT_ENTRIES=()
+
 # Extract a function body from objdump output file by matching the full header line.
 # The header has the form: <hex-addr> <full_demangled_name(...)>:
 # We grep for lines matching the short name prefix, then extract between
@@ -61,6 +78,64 @@ extract_func_body() {
         || true
 }
 
+# Function body as assembler input for llvm-mca: addresses, symbolic
+# annotations and comments stripped, branch and call targets replaced by a
+# placeholder symbol (only the instruction mix matters for the estimate).
+extract_mca_input() {
+    local dumpfile="$1"
+    local short_name="$2"
+    local header
+    header=$(grep -n "^[0-9a-f]* <${short_name}(" "$dumpfile" | grep -v '\[clone \.cold\]' | head -1 | cut -d: -f1)
+    [[ -n "$header" ]] || return 1
+    tail -n +"$((header + 1))" "$dumpfile" \
+        | sed '/^$/q' \
+        | grep -v '^$' \
+        | sed 's/^[[:space:]]*[0-9a-f]*:[[:space:]]*//' \
+        | sed 's/#.*$//' \
+        | sed 's/ <.*$//' \
+        | sed -E 's/^((j[a-z]+|call[a-z]*)[[:space:]]+)(\*?)[0-9a-f]+$/\1\3mca_target/' \
+        | grep -v '^\(nop\|data16\|cs nop\|xchg.*%ax,%ax\)' \
+        || true
+}
+
+# Block reciprocal throughput (cycles per iteration) from llvm-mca, or "null"
+mca_rthroughput() {
+    local input="$1"
+    if [[ -z "$LLVM_MCA" || -z "$input" ]]; then
+        echo null
+        return
+    fi
+    local args=()
+    [[ -n "${LLVM_MCA_CPU:-}" ]] && args+=("-mcpu=${LLVM_MCA_CPU}")
+    local value
+    value=$(echo "$input" | "$LLVM_MCA" "${args[@]}" 2>/dev/null \
+        | awk '/Block RThroughput:/ { print $3; exit }') || true
+    echo "${value:-null}"
+}
+
+# Append one JSON entry for a pair; $1 = key, $2 = status, $3 = refined asm,
+# $4 = plain asm, $5 = refined mca input, $6 = plain mca input
+record_pair() {
+    [[ -n "$REPORT" ]] || return 0
+    local key="$1" status="$2"
+    local ri pi rb pb rt pt td
+    ri=$(grep -c . <<< "$3" || true)
+    pi=$(grep -c . <<< "$4" || true)
+    rb=$(grep -c '^j' <<< "$3" || true)
+    pb=$(grep -c '^j' <<< "$4" || true)
+    rt=$(mca_rthroughput "$5")
+    pt=$(mca_rthroughput "$6")
+    if [[ "$rt" == null || "$pt" == null ]]; then
+        td=null
+    else
+        td=$(awk -v a="$rt" -v b="$pt" 'BEGIN { printf "%.2f", a - b }')
+    fi
+    printf "       insns %d vs %d (%+d), branches %d vs %d (%+d), rthroughput %s vs %s\n" \
+        "$ri" "$pi" "$((ri - pi))" "$rb" "$pb" "$((rb - pb))" "$rt" "$pt"
+    REPORT_ENTRIES+=("$(printf '"%s": {"status": "%s", "refined_insns": %d, "plain_insns": %d, "insn_delta": %d, "refined_branches": %d, "plain_branches": %d, "branch_delta": %d, "refined_rthroughput": %s, "plain_rthroughput": %s, "rthroughput_delta": %s}' \
+        "$key" "$status" "$ri" "$pi" "$((ri - pi))" "$rb" "$pb" "$((rb - pb))" "$rt" "$pt" "$td")")
+}
+
 for example in "${EXAMPLES[@]}"; do
     binary="${BUILD_DIR}/${PREFIX}${example}"
 
@@ -92,23 +167,31 @@ for example in "${EXAMPLES[@]}"; do
         refined_asm=$(echo "$refined_asm" | perl -pe 's/lea\s+\((%\w+),(%\w+)(?:,1)?\)/my @r = sort ($1,$2); "lea ($r[0],$r[1],1)"/e')
         plain_asm=$(echo "$plain_asm" | perl -pe 's/lea\s+\((%\w+),(%\w+)(?:,1)?\)/my @r = sort ($1,$2); "lea ($r[0],$r[1],1)"/e')
 
+        refined_mca=$(extract_mca_input "$DUMPFILE" "$refined_func") || refined_mca=""
+        plain_mca=$(extract_mca_input "$DUMPFILE" "$plain_func") || plain_mca=""
+        key="${example}/${refined_func}"
+
         if [[ -z "$refined_asm" ]]; then
             echo -e "${RED}MISS${RESET} ${example}: ${refined_func} not found in disassembly"
+            record_pair "$key" MISS "" "$plain_asm" "" "$plain_mca"
             DIFF=$((DIFF + 1))
             continue
         fi
 
         if [[ -z "$plain_asm" ]]; then
             echo -e "${RED}MISS${RESET} ${example}: ${plain_func} not found in disassembly"
+            record_pair "$key" MISS "$refined_asm" "" "$refined_mca" ""
             DIFF=$((DIFF + 1))
             continue
         fi
 
         if diff <(echo "$refined_asm") <(echo "$plain_asm") > /dev/null 2>&1; then
             echo -e "${GREEN}PASS${RESET} ${example}: ${refined_func} == ${plain_func}"
+            record_pair "$key" PASS "$refined_asm" "$plain_asm" "$refined_mca" "$plain_mca"
             PASS=$((PASS + 1))
         else
             echo -e "${RED}DIFF${RESET} ${example}: ${refined_func} != ${plain_func}"
+            record_pair "$key" DIFF "$refined_asm" "$plain_asm" "$refined_mca" "$plain_mca"
             diff --color=always <(echo "$refined_asm") <(echo "$plain_asm") || true
             echo ""
             DIFF=$((DIFF + 1))
@@ -116,6 +199,19 @@ for example in "${EXAMPLES[@]}"; do
     done
 done
 
+if [[ -n "$REPORT" ]]; then
+    {
+        echo "{"
+        for i in "${!REPORT_ENTRIES[@]}"; do
+            sep=","
+            [[ $i -eq $((${#REPORT_ENTRIES[@]} - 1)) ]] && sep=""
+            echo "  ${REPORT_ENTRIES[$i]}${sep}"
+        done
+        echo "}"
+    } > "$REPORT"
+    echo "Cost report written to ${REPORT}"
+fi
+
 echo ""
 echo -e "${BOLD}Results: ${GREEN}${PASS} passed${RESET}, ${RED}${DIFF} differ${RESET} (${TOTAL} total)"
 
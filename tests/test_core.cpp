@@ -0,0 +1,50 @@
+// test_core.cpp - core.hpp on its own: self-contained, without <format> or
+// <meta>. Nothing may be included before it.
+
+#include <refinery/core.hpp>
+
+#if !defined(REFINERY_INVENTORY) &&                                            \
+    (defined(__cpp_lib_format) || defined(__cpp_lib_reflection))
+#error "core.hpp must not include <format> or <meta>"
+#endif
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+
+using namespace refinery;
+
+namespace {
+
+constexpr auto IsPositive = [](int v) { return v > 0; };
+using Count = Refined<int, IsPositive>;
+
+} // namespace
+
+// ---- Core-Only Tests ----
+
+TEST(CoreOnly, ConstructionPaths) {
+    constexpr Count three{3};
+    EXPECT_EQ(three.get(), 3);
+    EXPECT_EQ(Count(4, runtime_check).get(), 4);
+    EXPECT_EQ(Count(5, assume_valid).get(), 5);
+    EXPECT_THROW((Count(-1, runtime_check)), refinement_error);
+    EXPECT_FALSE(try_refine<Count>(0).has_value());
+    EXPECT_EQ(try_refine_expected<Count>(-2).error(), -2);
+
+    const IntervalRefined<int, 0, 10> digit{5};
+    const Refined<int, Interval<-1, 11>{}> widened = digit;
+    EXPECT_EQ(widened.get(), 5);
+}
+
+TEST(CoreOnly, ErrorMessagesWithoutFormat) {
+    try {
+        (void)Count(-7, runtime_check);
+        FAIL() << "expected refinement_error";
+    } catch (const refinement_error& e) {
+        EXPECT_STREQ(e.what(),
+                     "Refinement violation: -7 does not satisfy predicate");
+    }
+    EXPECT_STREQ(refinement_error(std::string("x"), "Named").what(),
+                 "Refinement violation: x does not satisfy Named");
+}
@@ -0,0 +1,107 @@
+// test_inventory.cpp - Construction inventory (built with REFINERY_INVENTORY)
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <refinery/atomic.hpp>
+#include <refinery/refinery.hpp>
+#include <refinery/vector.hpp>
+#include <vector>
+
+using namespace refinery;
+
+namespace {
+
+struct Digit {
+    static constexpr int lo = 1;
+    static constexpr int hi = 9;
+    constexpr bool operator()(int v) const { return v >= lo && v <= hi; }
+};
+
+template <typename R>
+std::uint64_t recorded(const std::vector<inventory_entry>& entries,
+                       construction path) {
+    auto it = std::ranges::find_if(entries, [&](const inventory_entry& e) {
+        return e.type.name == describe<R>().name && e.path == path;
+    });
+    return it == entries.end() ? ~std::uint64_t{0} : it->count;
+}
+
+} // namespace
+
+// ---- Inventory Tests ----
+
+TEST(Inventory, DescribeReportsKindAndBounds) {
+    constexpr auto score = describe<IntervalRefined<int, 0, 100>>();
+    static_assert(score.kind == predicate_kind::interval);
+    static_assert(score.interval_structural);
+    EXPECT_FALSE(score.name.empty());
+    EXPECT_FALSE(score.lo.empty());
+
+    constexpr auto digit = describe<Refined<int, Digit{}>>();
+    static_assert(digit.kind == predicate_kind::bounded);
+    static_assert(!digit.interval_structural);
+
+    constexpr auto positive = describe<Refined<int, Positive>>();
+    static_assert(positive.kind == predicate_kind::opaque);
+    EXPECT_TRUE(positive.lo.empty());
+    EXPECT_NE(positive.name, score.name);
+}
+
+TEST(Inventory, RecordsEveryConstructionPath) {
+    using Percent = IntervalRefined<int, 0, 77>;
+    using Wide = IntervalRefined<int, -1, 78>;
+
+    constexpr Percent fixed{7};
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(Percent(i, runtime_check).get(), i);
+    }
+    Percent trusted(5, assume_valid);
+    Wide widened = trusted;
+
+    auto entries = inventory();
+    EXPECT_EQ(recorded<Percent>(entries, construction::runtime_check), 3u);
+    EXPECT_EQ(recorded<Percent>(entries, construction::assume_valid), 1u);
+    EXPECT_EQ(recorded<Percent>(entries, construction::compile_time), 0u);
+    EXPECT_EQ(recorded<Wide>(entries, construction::implied), 1u);
+    EXPECT_EQ(fixed.get() + widened.get(), 12);
+}
+
+TEST(Inventory, CheckingHelpersCountAsRuntimeChecks) {
+    using Small = IntervalRefined<int, 0, 55>;
+    EXPECT_TRUE(try_refine<Small>(3).has_value());
+    EXPECT_FALSE(try_refine<Small>(99).has_value());
+    EXPECT_TRUE(try_refine_expected<Small>(4).has_value());
+
+    using Element = IntervalRefined<int, 0, 56>;
+    RefinedVector<int, Interval<0, 56>{}> values;
+    values.push_back(1);
+    values.assign(std::vector<int>{1, 2, 3});
+    AtomicRefined<int, Interval<0, 56>{}> counter{Element{0}};
+    EXPECT_TRUE(counter.try_fetch_add(5).has_value());
+    EXPECT_EQ(counter.load().get(), 5);
+
+    auto entries = inventory();
+    EXPECT_EQ(recorded<Small>(entries, construction::runtime_check), 3u);
+    EXPECT_EQ(recorded<Small>(entries, construction::assume_valid),
+              ~std::uint64_t{0});
+    EXPECT_EQ(recorded<Element>(entries, construction::runtime_check), 5u);
+    EXPECT_EQ(recorded<Element>(entries, construction::assume_valid),
+              ~std::uint64_t{0});
+}
+
+TEST(Inventory, HotRuntimeChecksComeFirst) {
+    using Hot = IntervalRefined<int, 0, 1000>;
+    for (int i = 0; i < 1000; ++i) {
+        static_cast<void>(Hot(i, runtime_check));
+    }
+
+    auto entries = inventory();
+    ASSERT_FALSE(entries.empty());
+    EXPECT_EQ(entries.front().path, construction::runtime_check);
+    EXPECT_EQ(entries.front().type.name, describe<Hot>().name);
+    EXPECT_EQ(entries.front().count, 1000u);
+
+    auto report = inventory_report();
+    EXPECT_EQ(report.find("runtime_check"), 0u);
+    EXPECT_NE(report.find("interval ["), std::string::npos);
+}
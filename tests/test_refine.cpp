@@ -1,11 +1,27 @@
 // test_refine.cpp - Test suite for C++26 Refinement Types Library
 
+#include <array>
 #include <cmath>
 #include <gtest/gtest.h>
 #include <limits>
+#include <memory_resource>
 #include <numbers>
+#include <thread>
+#include <refinery/atomic.hpp>
+#include <refinery/column.hpp>
+#include <refinery/counter.hpp>
 #include <refinery/domain.hpp>
+#include <refinery/envelope.hpp>
+#include <refinery/generate.hpp>
+#include <refinery/inline_storage.hpp>
+#include <refinery/modify.hpp>
 #include <refinery/refinery.hpp>
+#include <refinery/registry.hpp>
+#include <refinery/ring.hpp>
+#include <refinery/snapshot.hpp>
+#include <refinery/static_data.hpp>
+#include <refinery/vector.hpp>
+#include <refinery/zone_map.hpp>
 
 using namespace refinery;
 
@@ -846,6 +862,24 @@ TEST(SaturatingArith, EdgeCases) {
     static_assert(sat_neg(0) == 0);
 }
 
+TEST(IntervalBounds, ValueComputation) {
+    using namespace refinery::interval_math;
+    constexpr auto m = mul_bounds(bounds<int>{-2, 3}, bounds<int>{-5, 4});
+    static_assert(m.lo == -15 && m.hi == 12);
+    constexpr auto s = sub_bounds(bounds_of(Interval<0, 10>{}),
+                                  bounds_of(Interval<1, 2>{}));
+    static_assert(s.lo == -2 && s.hi == 9);
+    static_assert(std::same_as<decltype(interval_of<bounds<int>{0, 100}>),
+                               const Interval<0, 100>>);
+
+    // Results are keyed on their bounds: different operands, same type
+    IntervalRefined<int, 0, 10> a{2, runtime_check};
+    IntervalRefined<int, 0, 20> b{3, runtime_check};
+    IntervalRefined<int, 0, 5> c{4, runtime_check};
+    static_assert(std::same_as<decltype(a * a), decltype(b * c)>);
+    EXPECT_EQ((b * c).get(), 12);
+}
+
 TEST(Interval, IntegerOverflowThrows) {
     // Addition that overflows
     IntervalRefined<int, 1, std::numeric_limits<int>::max()> big{
@@ -1078,3 +1112,1445 @@ TEST(Operations, FloatArithmeticUnchanged) {
     static_assert(std::same_as<decltype(neg), double>);
     EXPECT_DOUBLE_EQ(neg, -5.0);
 }
+
+// ---- Refined Column Tests ----
+
+TEST(RefinedColumn, ValidityBitmap) {
+    std::vector<int> raw{5, -1, 3, 0, 7, -8, 9, 10, 11};
+    RefinedColumn<int, Positive> col(raw);
+
+    EXPECT_EQ(col.size(), 9u);
+    EXPECT_EQ(col.valid_count(), 6u);
+    EXPECT_EQ(col.null_count(), 3u);
+
+    // LSB-first: rows 0, 2, 4, 6, 7 in byte 0, row 8 in byte 1
+    ASSERT_EQ(col.validity_bitmap().size(), 2u);
+    EXPECT_EQ(col.validity_bitmap()[0], 0b11010101);
+    EXPECT_EQ(col.validity_bitmap()[1], 0b00000001);
+
+    EXPECT_TRUE(col.is_valid(0));
+    EXPECT_FALSE(col.is_valid(1));
+    EXPECT_FALSE(col.at(3).has_value());
+    ASSERT_TRUE(col.at(4).has_value());
+    EXPECT_EQ(col.at(4)->get(), 7);
+    EXPECT_FALSE(col.at(100).has_value());
+}
+
+TEST(RefinedColumn, IteratesValidRowsOnly) {
+    // Large enough to exercise the 64-element block path
+    std::vector<int> raw(200);
+    for (int i = 0; i < 200; ++i) {
+        raw[i] = (i % 3 == 0) ? -i : i;
+    }
+    RefinedColumn<int, Positive> col(std::move(raw));
+
+    std::size_t count = 0;
+    for (auto it = col.begin(); it != col.end(); ++it) {
+        static_assert(std::same_as<decltype(*it), Refined<int, Positive>>);
+        EXPECT_NE(it.index() % 3, 0u);
+        EXPECT_EQ((*it).get(), static_cast<int>(it.index()));
+        ++count;
+    }
+    EXPECT_EQ(count, col.valid_count());
+    EXPECT_EQ(col.null_count(), 67u); // 0, 3, ..., 198
+}
+
+TEST(RefinedColumn, PushBackAndAppend) {
+    RefinedColumn<int, Interval<0, 10>{}> col;
+    EXPECT_TRUE(col.push_back(3));
+    EXPECT_FALSE(col.push_back(42));
+    col.push_back(IntervalRefined<int, 0, 10>{7, runtime_check});
+
+    std::vector<int> batch{1, 2, 11, 4, -1};
+    EXPECT_EQ(col.append(batch), 3u);
+
+    EXPECT_EQ(col.size(), 8u);
+    EXPECT_EQ(col.null_count(), 3u);
+
+    std::vector<int> valid;
+    for (auto v : col) {
+        valid.push_back(v.get());
+    }
+    EXPECT_EQ(valid, (std::vector<int>{3, 7, 1, 2, 4}));
+}
+
+TEST(RefinedColumn, ArrowExport) {
+    std::vector<std::int32_t> raw{1, -2, 3, 4};
+    RefinedColumn<std::int32_t, Positive> col(std::move(raw));
+    const void* values_ptr = col.values().data();
+
+    ArrowArray array{};
+    ArrowSchema schema{};
+    export_arrow(std::move(col), &array, &schema);
+
+    EXPECT_STREQ(schema.format, "i");
+    EXPECT_EQ(schema.flags, ARROW_FLAG_NULLABLE);
+    EXPECT_EQ(array.length, 4);
+    EXPECT_EQ(array.null_count, 1);
+    EXPECT_EQ(array.n_buffers, 2);
+    // Zero-copy: the values buffer is the column's own storage
+    EXPECT_EQ(array.buffers[1], values_ptr);
+    ASSERT_NE(array.buffers[0], nullptr);
+    EXPECT_EQ(*static_cast<const std::uint8_t*>(array.buffers[0]), 0b1101);
+
+    array.release(&array);
+    schema.release(&schema);
+    EXPECT_EQ(array.release, nullptr);
+    EXPECT_EQ(schema.release, nullptr);
+}
+
+// ---- Zone Map Tests ----
+
+TEST(ZoneMap, BlockSummaries) {
+    std::vector<int> raw(10);
+    for (int i = 0; i < 10; ++i) {
+        raw[i] = i * 10; // 0, 10, ..., 90
+    }
+    ZoneMap<int, 8> zones{std::span<const int>(raw)};
+    ASSERT_EQ(zones.block_count(), 2u);
+    EXPECT_EQ(zones.zones()[0].min, 0);
+    EXPECT_EQ(zones.zones()[0].max, 70);
+    EXPECT_EQ(zones.zones()[1].min, 80);
+    EXPECT_EQ(zones.zones()[1].max, 90);
+    EXPECT_EQ(zones.zones()[1].count, 2u);
+
+    EXPECT_EQ((zones.match<Interval<0, 100>{}>(0)), zone_match::all);
+    EXPECT_EQ((zones.match<Interval<75, 100>{}>(0)), zone_match::none);
+    EXPECT_EQ((zones.match<Interval<75, 100>{}>(1)), zone_match::all);
+    EXPECT_EQ((zones.match<Interval<50, 85>{}>(1)), zone_match::partial);
+}
+
+TEST(ZoneMap, RevalidateAgainstTighterInterval) {
+    std::vector<int> raw(64);
+    for (int i = 0; i < 64; ++i) {
+        raw[i] = i < 32 ? i : -i; // block 0, 1: in range; blocks 2, 3: not
+    }
+    raw[40] = 5;
+    RefinedColumn<int, Interval<-100, 100>{}> col(std::move(raw));
+    ZoneMap<int, 16> zones(col);
+
+    auto tight = revalidate<Interval<0, 50>{}>(std::move(col), zones);
+    static_assert(std::same_as<decltype(tight),
+                               RefinedColumn<int, Interval<0, 50>{}>>);
+    EXPECT_EQ(tight.size(), 64u);
+    EXPECT_EQ(tight.valid_count(), 33u);
+    EXPECT_TRUE(tight.is_valid(31));
+    EXPECT_TRUE(tight.is_valid(40));
+    EXPECT_FALSE(tight.is_valid(41));
+}
+
+TEST(ZoneMap, RevalidateImpliedKeepsBitmap) {
+    std::vector<int> raw{1, 200, 3};
+    RefinedColumn<int, Interval<0, 10>{}> col(std::move(raw));
+    ZoneMap<int, 8> zones(col);
+    auto wider = revalidate<Interval<-5, 50>{}>(std::move(col), zones);
+    EXPECT_EQ(wider.valid_count(), 2u);
+    EXPECT_FALSE(wider.is_valid(1));
+}
+
+TEST(ZoneMap, SelectRows) {
+    std::vector<double> raw(40);
+    for (int i = 0; i < 40; ++i) {
+        raw[i] = static_cast<double>(i);
+    }
+    raw[3] = std::numeric_limits<double>::quiet_NaN();
+    ZoneMap<double, 8> zones{std::span<const double>(raw)};
+    // NaN forces its block to be checked row by row
+    EXPECT_EQ((zones.match<Interval<0.0, 100.0>{}>(0)), zone_match::partial);
+
+    auto rows =
+        select_rows<Interval<6.0, 17.0>{}>(std::span<const double>(raw), zones);
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 6; i <= 17; ++i) {
+        expected.push_back(i);
+    }
+    EXPECT_EQ(rows, expected);
+
+    RefinedColumn<double, Positive> col{std::span<const double>(raw)};
+    ZoneMap<double, 8> col_zones(col);
+    auto col_rows = select_rows<Interval<0.0, 4.0>{}>(col, col_zones);
+    EXPECT_EQ(col_rows, (std::vector<std::size_t>{1, 2, 4}));
+}
+
+// ---- RefinedVector Tests ----
+
+TEST(RefinedVector, ValidatedPushAndEmplace) {
+    RefinedVector<int, Positive> v;
+    v.push_back(3);
+    v.push_back(Refined<int, Positive>{5});
+    EXPECT_EQ(v.emplace_back(7).get(), 7);
+    EXPECT_THROW(v.push_back(-1), refinement_error);
+    EXPECT_THROW(v.emplace_back(0), refinement_error);
+
+    ASSERT_EQ(v.size(), 3u);
+    EXPECT_EQ(v[0].get(), 3);
+    EXPECT_EQ(v.back().get(), 7);
+    EXPECT_THROW((void)v.at(3), std::out_of_range);
+}
+
+TEST(RefinedVector, InsertAndErase) {
+    RefinedVector<int, Positive> v(std::vector<int>{1, 4}, runtime_check);
+    v.insert(v.begin() + 1, 2);
+    std::vector<int> batch{3, 3};
+    auto it = v.insert(v.begin() + 2, std::span<const int>(batch));
+    EXPECT_EQ(it - v.begin(), 2);
+    v.emplace(v.end(), 5);
+
+    std::vector<int> bad{6, -6};
+    EXPECT_THROW(v.insert(v.end(), std::span<const int>(bad)),
+                 refinement_error);
+    EXPECT_THROW(v.insert(v.begin(), 0), refinement_error);
+
+    v.erase(v.begin() + 2);
+    EXPECT_EQ(std::vector<int>(v.values().begin(), v.values().end()),
+              (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+TEST(RefinedVector, AssignIsAllOrNothing) {
+    RefinedVector<int, Interval<0, 9>{}> v;
+    std::vector<int> good(100, 4);
+    v.assign(good);
+    EXPECT_EQ(v.size(), 100u);
+
+    std::vector<int> bad(100, 4);
+    bad[97] = 10;
+    EXPECT_THROW(v.assign(bad), refinement_error);
+    EXPECT_EQ(v.size(), 100u);
+    EXPECT_THROW((RefinedVector<int, Interval<0, 9>{}>(bad, runtime_check)),
+                 refinement_error);
+}
+
+TEST(RefinedVector, SpanViews) {
+    RefinedVector<double, Positive> v(std::vector<double>{1.5, 2.5},
+                                      runtime_check);
+    std::span<const Refined<double, Positive>> refined = v.refined();
+    std::span<const double> raw = v.values();
+    EXPECT_EQ(static_cast<const void*>(refined.data()),
+              static_cast<const void*>(raw.data()));
+    EXPECT_EQ(refined[1].get(), 2.5);
+
+    double sum = 0;
+    for (const auto& x : v) {
+        sum += x.get();
+    }
+    EXPECT_DOUBLE_EQ(sum, 4.0);
+}
+
+TEST(RefinedVector, StoresRefinedElements) {
+    RefinedVector<std::string, NonEmpty> names(
+        std::vector<std::string>{"ada", "grace"}, runtime_check);
+    static_assert(std::same_as<decltype(names.refined()),
+                               std::span<const Refined<std::string, NonEmpty>>>);
+    names[1] = std::string("alan");
+    EXPECT_THROW(names[0] = std::string(), refinement_error);
+    const Refined<std::string, NonEmpty>& first = names[0];
+    EXPECT_EQ(&first, &names.refined()[0]);
+
+    const std::vector<std::string> raw = std::move(names).release();
+    EXPECT_EQ(raw, (std::vector<std::string>{"ada", "alan"}));
+}
+
+TEST(RefinedVector, AllElementsConversion) {
+    constexpr auto all_positive = AllElements<Positive>;
+    static_assert(all_positive(std::vector<int>{1, 2, 3}));
+    static_assert(!all_positive(std::vector<int>{1, -2, 3}));
+
+    RefinedVector<int, Positive> v(std::vector<int>{1, 2}, runtime_check);
+    auto whole = std::move(v).to_refined();
+    static_assert(
+        std::same_as<decltype(whole),
+                     Refined<std::vector<int>, AllElements<Positive>>>);
+    EXPECT_EQ(whole->size(), 2u);
+
+    RefinedVector<int, Positive> back(std::move(whole));
+    EXPECT_EQ(back.size(), 2u);
+}
+
+// ---- Incremental Modification Tests ----
+
+TEST(Modify, ScalarCommitsOrThrows) {
+    PositiveI32 p{5, runtime_check};
+    modify(p, [](std::int32_t& v) { v += 10; });
+    EXPECT_EQ(p.get(), 15);
+
+    EXPECT_THROW(modify(p, [](std::int32_t& v) { v = -1; }), refinement_error);
+    EXPECT_EQ(p.get(), 15);
+}
+
+TEST(Modify, AllElementsChecksTouchedOnly) {
+    Refined<std::vector<int>, AllElements<Positive>> v{
+        std::vector<int>(1000, 1), runtime_check};
+
+    modify(v, [](tracked_view<int>& view) {
+        view[10] = 42;
+        EXPECT_EQ(view.get(11), 1);
+    });
+    EXPECT_EQ((*v)[10], 42);
+
+    EXPECT_THROW(modify(v,
+                        [](tracked_view<int>& view) {
+                            view[3] = 7;
+                            view[500] = -1;
+                        }),
+                 refinement_error);
+    // Rolled back: neither write is visible
+    EXPECT_EQ((*v)[3], 1);
+    EXPECT_EQ((*v)[500], 1);
+    EXPECT_EQ(v->size(), 1000u);
+}
+
+TEST(Modify, SortedChecksBoundaries) {
+    Refined<std::vector<int>, Sorted> v{std::vector<int>{1, 3, 5, 7, 9},
+                                        runtime_check};
+    modify(v, [](tracked_view<int>& view) { view[2] = 6; });
+    EXPECT_EQ((*v)[2], 6);
+
+    // 8 at index 1 breaks ordering with its right neighbour
+    EXPECT_THROW(modify(v, [](tracked_view<int>& view) { view[1] = 8; }),
+                 refinement_error);
+    EXPECT_EQ((*v)[1], 3);
+
+    modify(v, [](tracked_view<int>& view) {
+        auto s = view.mutable_span(3, 2);
+        s[0] = 100;
+        s[1] = 200;
+    });
+    EXPECT_EQ(*v, (std::vector<int>{1, 3, 6, 100, 200}));
+}
+
+TEST(Modify, RefinedVectorRollsBackOnException) {
+    RefinedVector<int, Positive> v(std::vector<int>{1, 2, 3}, runtime_check);
+    EXPECT_THROW(modify(v,
+                        [](tracked_view<int>& view) {
+                            view[0] = 10;
+                            throw std::runtime_error("abort");
+                        }),
+                 std::runtime_error);
+    EXPECT_EQ(v[0].get(), 1);
+
+    modify(v, [](tracked_view<int>& view) { view[2] = 30; });
+    EXPECT_EQ(v[2].get(), 30);
+}
+
+TEST(Modify, DirtyRangesMerge) {
+    std::vector<int> data(10, 0);
+    tracked_view<int> view{std::span<int>(data)};
+    view[5] = 1;
+    view[4] = 1;
+    (void)view.mutable_span(6, 2);
+    view[0] = 1;
+    auto ranges = view.dirty_ranges();
+    ASSERT_EQ(ranges.size(), 2u);
+    EXPECT_EQ(ranges[0], (std::pair<std::size_t, std::size_t>{0, 1}));
+    EXPECT_EQ(ranges[1], (std::pair<std::size_t, std::size_t>{4, 8}));
+    view.rollback();
+    EXPECT_EQ(data, std::vector<int>(10, 0));
+
+    // A span over several ranges and the gaps between them joins them
+    view[9] = 2;
+    view[2] = 2;
+    view[5] = 2;
+    for (int& x : view.mutable_span(1, 6)) {
+        x = 3;
+    }
+    ranges = view.dirty_ranges();
+    ASSERT_EQ(ranges.size(), 2u);
+    EXPECT_EQ(ranges[0], (std::pair<std::size_t, std::size_t>{1, 7}));
+    EXPECT_EQ(ranges[1], (std::pair<std::size_t, std::size_t>{9, 10}));
+    view.rollback();
+    EXPECT_EQ(data, std::vector<int>(10, 0));
+}
+
+TEST(Modify, EachElementSavedOnce) {
+    struct Counted {
+        int value = 0;
+        int* copies = nullptr;
+        Counted(int v, int* c) : value(v), copies(c) {}
+        Counted(const Counted& other)
+            : value(other.value), copies(other.copies) {
+            ++*copies;
+        }
+        Counted& operator=(const Counted&) = default;
+        Counted(Counted&&) noexcept = default;
+        Counted& operator=(Counted&&) noexcept = default;
+    };
+    int copies = 0;
+    std::vector<Counted> data;
+    for (int i = 0; i < 4; ++i) {
+        data.emplace_back(i, &copies);
+    }
+    tracked_view<Counted> view{std::span<Counted>(data)};
+    for (int k = 0; k < 1000; ++k) {
+        view[1].value = k;
+        view[2].value = k;
+        (void)view.mutable_span(1, 2);
+    }
+    EXPECT_EQ(copies, 2);
+    auto ranges = view.dirty_ranges();
+    ASSERT_EQ(ranges.size(), 1u);
+    EXPECT_EQ(ranges[0], (std::pair<std::size_t, std::size_t>{1, 3}));
+    view.rollback();
+    EXPECT_EQ(data[1].value, 1);
+    EXPECT_EQ(data[2].value, 2);
+}
+
+// ---- RefinedRef Tests ----
+
+TEST(RefinedRef, ValidatedWriteThrough) {
+    RefinedVector<int, Positive> v(std::vector<int>{1, 2, 3}, runtime_check);
+    static_assert(std::same_as<decltype(v[0]), RefinedRef<int, Positive>>);
+
+    v[0] = 10;
+    EXPECT_EQ(v.values()[0], 10);
+    EXPECT_THROW(v[1] = -5, refinement_error);
+    EXPECT_EQ(v.values()[1], 2);
+
+    EXPECT_TRUE(v[2].try_assign(30));
+    EXPECT_FALSE(v[2].try_assign(0));
+    EXPECT_EQ(*v[2], 30);
+
+    v[1] = Refined<int, Positive>{7};
+    v[0] = v[1]; // proxy assignment copies the value
+    EXPECT_EQ(v.values()[0], 7);
+
+    const Refined<int, Positive>& r = v[2];
+    EXPECT_EQ(r.get(), 30);
+}
+
+TEST(RefinedRef, AssignRange) {
+    RefinedVector<int, Interval<0, 100>{}> v(std::vector<int>(200, 0),
+                                             runtime_check);
+    std::vector<int> patch(100, 50);
+    v.assign_range(50, patch);
+    EXPECT_EQ(v.values()[49], 0);
+    EXPECT_EQ(v.values()[50], 50);
+    EXPECT_EQ(v.values()[149], 50);
+
+    patch[99] = 101;
+    EXPECT_THROW(v.assign_range(0, patch), refinement_error);
+    EXPECT_EQ(v.values()[0], 0);
+    EXPECT_THROW(v.assign_range(150, std::vector<int>(60, 1)),
+                 std::out_of_range);
+}
+
+// ---- In-place Construction Tests ----
+
+namespace {
+
+struct MoveCounter {
+    static inline int moves = 0;
+    std::string text;
+
+    MoveCounter(std::size_t n, char c) : text(n, c) {}
+    MoveCounter(const MoveCounter&) = default;
+    MoveCounter(MoveCounter&& other) noexcept : text(std::move(other.text)) {
+        ++moves;
+    }
+};
+
+constexpr auto HasText = [](const MoveCounter& m) { return !m.text.empty(); };
+
+} // namespace
+
+TEST(InPlace, EmplaceConstructsOnce) {
+    MoveCounter::moves = 0;
+    auto r = Refined<MoveCounter, HasText>::emplace(3, 'x');
+    EXPECT_EQ(r->text, "xxx");
+    EXPECT_EQ(MoveCounter::moves, 0);
+
+    EXPECT_THROW((Refined<MoveCounter, HasText>::emplace(0, 'x')),
+                 refinement_error);
+
+    Refined<std::string, NonEmpty> s(std::in_place, 4, 'a');
+    EXPECT_EQ(s.get(), "aaaa");
+}
+
+TEST(InPlace, TryRefineKeepsRejectedValue) {
+    using NonEmptyString = Refined<std::string, NonEmpty>;
+
+    std::string empty;
+    empty.reserve(64);
+    const char* buffer = empty.data();
+    EXPECT_FALSE(try_refine<NonEmptyString>(std::move(empty)).has_value());
+    // Rejected rvalue is not moved from: the caller keeps its buffer
+    EXPECT_EQ(empty.data(), buffer);
+
+    std::string hello = "hello";
+    auto copied = try_refine<NonEmptyString>(hello);
+    ASSERT_TRUE(copied.has_value());
+    EXPECT_EQ(hello, "hello");
+
+    auto moved = try_refine<NonEmpty>(std::string("world"));
+    static_assert(std::same_as<decltype(moved), std::optional<NonEmptyString>>);
+    ASSERT_TRUE(moved.has_value());
+    EXPECT_EQ(moved->get(), "world");
+}
+
+TEST(InPlace, TryRefineCopyMayThrow) {
+    struct Fragile {
+        int value;
+        explicit Fragile(int v) : value(v) {}
+        Fragile(const Fragile&) { throw std::bad_alloc(); }
+        Fragile(Fragile&&) noexcept = default;
+    };
+    constexpr auto Valid = [](const Fragile& f) { return f.value > 0; };
+    using Checked = Refined<Fragile, Valid>;
+
+    Fragile lvalue(1);
+    static_assert(!noexcept(try_refine<Checked>(lvalue)));
+    EXPECT_THROW((void)try_refine<Checked>(lvalue), std::bad_alloc);
+    EXPECT_THROW((void)try_refine<Valid>(lvalue), std::bad_alloc);
+    const Checked stored(Fragile(2), assume_valid);
+    EXPECT_THROW((void)try_refine_to<Checked>(stored), std::bad_alloc);
+
+    static_assert(noexcept(try_refine<Checked>(std::move(lvalue))));
+    EXPECT_EQ(try_refine<Checked>(Fragile(3))->get().value, 3);
+    static_assert(noexcept(try_refine<PositiveI32>(1)));
+}
+
+TEST(InPlace, TryRefineExpected) {
+    using NonEmptyString = Refined<std::string, NonEmpty>;
+
+    auto ok = try_refine_expected<NonEmptyString>(std::string("abc"));
+    ASSERT_TRUE(ok.has_value());
+    EXPECT_EQ(ok->get(), "abc");
+
+    std::string big(100, 'z');
+    big.clear();
+    const auto capacity = big.capacity();
+    auto rejected = try_refine_expected<NonEmptyString>(std::move(big));
+    ASSERT_FALSE(rejected.has_value());
+    // The rejected string (and its allocation) is handed back
+    EXPECT_EQ(rejected.error().capacity(), capacity);
+}
+
+// ---- Inline Storage Tests ----
+
+TEST(InlineStorage, SizeBoundsPredicates) {
+    static_assert(SizeAtMost(3)(std::string("abc")));
+    static_assert(!SizeAtMost(2)(std::string("abc")));
+    static_assert(SizeAtLeast(1)(std::string("a")));
+    static_assert(SizeExactly(2)(std::string_view("ab")));
+    static_assert(!SizeInRange(2, 4)(std::string_view("abcde")));
+    static_assert(SizeInRange(2, 4).min_size == 2 &&
+                  SizeInRange(2, 4).max_size == 4);
+}
+
+TEST(InlineStorage, CompactSelection) {
+    static_assert(std::same_as<CompactRefined<std::string, SizeAtMost(16)>,
+                               Refined<inline_string<16>, SizeAtMost(16)>>);
+    static_assert(std::same_as<compact_storage_t<std::vector<int>,
+                                                 SizeInRange(1, 8)>,
+                               static_vector<int, 8>>);
+    // Unbounded or too-large bounds keep the heap-backed type
+    static_assert(std::same_as<compact_storage_t<std::string, SizeAtLeast(1)>,
+                               std::string>);
+    static_assert(
+        std::same_as<compact_storage_t<std::string, SizeAtMost(1'000'000)>,
+                     std::string>);
+    static_assert(std::same_as<compact_storage_t<std::string, NonEmpty>,
+                               std::string>);
+
+    // Narrow size type and no heap pointer
+    static_assert(std::same_as<inline_string<16>::size_type, std::uint8_t>);
+    static_assert(std::same_as<inline_string<300>::size_type, std::uint16_t>);
+    static_assert(sizeof(inline_string<15>) == 17);
+}
+
+TEST(InlineStorage, InlineString) {
+    inline_string<8> s("abc");
+    EXPECT_EQ(s.size(), 3u);
+    s.push_back('d');
+    s.append("efgh");
+    EXPECT_EQ(s, std::string_view("abcdefgh"));
+    EXPECT_STREQ(s.c_str(), "abcdefgh");
+    EXPECT_THROW(s.push_back('x'), std::length_error);
+    EXPECT_THROW(inline_string<2>("abc"), std::length_error);
+    EXPECT_EQ(std::format("{}", s), "abcdefgh");
+    EXPECT_LT(inline_string<8>("abc"), inline_string<8>("abd"));
+}
+
+TEST(InlineStorage, StaticVector) {
+    static_vector<std::string, 3> v{"a", "b"};
+    v.emplace_back(2, 'c');
+    EXPECT_EQ(v.size(), 3u);
+    EXPECT_EQ(v[2], "cc");
+    EXPECT_THROW(v.push_back("d"), std::length_error);
+
+    auto copy = v;
+    auto moved = std::move(v);
+    EXPECT_EQ(copy, moved);
+    EXPECT_TRUE(v.empty());
+    moved.pop_back();
+    EXPECT_EQ(moved.back(), "b");
+}
+
+TEST(InlineStorage, RefineCompact) {
+    using Tag = CompactRefined<std::string, SizeInRange(1, 8)>;
+    auto tag = try_refine_compact<Tag>(std::string_view("prod"));
+    ASSERT_TRUE(tag.has_value());
+    EXPECT_EQ(tag->get(), std::string_view("prod"));
+
+    // Over-long input is rejected before it is copied into inline storage
+    EXPECT_FALSE(try_refine_compact<Tag>(std::string_view("production"))
+                     .has_value());
+    EXPECT_FALSE(try_refine_compact<Tag>(std::string_view("")).has_value());
+    EXPECT_THROW((void)refine_compact<Tag>(std::string_view("production")),
+                 refinement_error);
+
+    using Tags = CompactRefined<std::vector<int>, SizeAtMost(4)>;
+    std::vector<int> raw{1, 2, 3};
+    auto tags = refine_compact<Tags>(std::span<const int>(raw));
+    EXPECT_EQ(tags->size(), 3u);
+    EXPECT_EQ((*tags)[2], 3);
+
+    Tag runtime{inline_string<8>("dev"), runtime_check};
+    EXPECT_EQ(runtime->size(), 3u);
+}
+
+// ---- Arena Allocation Tests ----
+
+TEST(ArenaAllocation, PmrRefinedVectorUsesArena) {
+    std::array<std::byte, 4096> buffer;
+    std::pmr::monotonic_buffer_resource arena(
+        buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    pmr::RefinedVector<int, Positive> v(&arena);
+    v.push_back(1);
+    v.push_back(2);
+    EXPECT_THROW(v.push_back(0), refinement_error);
+    EXPECT_EQ(v.get_allocator().resource(), &arena);
+
+    const auto* first = reinterpret_cast<const std::byte*>(v.values().data());
+    EXPECT_GE(first, buffer.data());
+    EXPECT_LT(first, buffer.data() + buffer.size());
+
+    modify(v, [](tracked_view<int>& view) { view[0] = 5; });
+    EXPECT_EQ(v[0].get(), 5);
+    EXPECT_EQ(v.get_allocator().resource(), &arena);
+}
+
+TEST(ArenaAllocation, NestedContainersPropagateResource) {
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<pmr::RefinedVector<int, Positive>> graph(&arena);
+    graph.emplace_back();
+    graph.back().push_back(7);
+    graph.emplace_back(graph.front());
+
+    // Uses-allocator construction hands the arena to every inner vector
+    for (const auto& inner : graph) {
+        EXPECT_EQ(inner.get_allocator().resource(), &arena);
+    }
+    EXPECT_EQ(graph[1][0].get(), 7);
+}
+
+TEST(ArenaAllocation, AppendValidFiltersInBulk) {
+    std::vector<int> raw(200);
+    for (int i = 0; i < 200; ++i) {
+        raw[static_cast<std::size_t>(i)] = i % 3 == 0 ? -i : i;
+    }
+    std::pmr::monotonic_buffer_resource arena;
+    pmr::RefinedVector<int, Positive> v(&arena);
+    v.reserve(raw.size());
+
+    const auto appended = v.append_valid(raw);
+    EXPECT_EQ(appended, v.size());
+    EXPECT_EQ(v.size(), 133u);
+    EXPECT_EQ(v.front().get(), 1);
+    EXPECT_EQ(v.back().get(), 199);
+
+    auto whole = std::move(v).to_refined();
+    static_assert(
+        std::same_as<decltype(whole),
+                     Refined<std::pmr::vector<int>, AllElements<Positive>>>);
+    EXPECT_EQ(whole.get().get_allocator().resource(), &arena);
+}
+
+// ---- AtomicRefined Tests ----
+
+TEST(AtomicRefined, LoadStoreAndCompareExchange) {
+    using Percent = Refined<int, Interval<0, 100>{}>;
+    AtomicRefined<int, Interval<0, 100>{}> a(Percent(10, runtime_check));
+    EXPECT_EQ(a.load().get(), 10);
+
+    a.store(Percent(20, runtime_check));
+    Percent expected(10, runtime_check);
+    const Percent desired(30, runtime_check);
+    EXPECT_FALSE(a.compare_exchange_strong(expected, desired));
+    EXPECT_EQ(expected.get(), 20);
+    EXPECT_TRUE(a.compare_exchange_strong(expected, desired));
+    EXPECT_EQ(a.exchange(Percent(40, runtime_check)).get(), 30);
+}
+
+TEST(AtomicRefined, RefusesUpdatesLeavingInterval) {
+    using Budget = Refined<int, Interval<0, 100>{}>;
+    AtomicRefined<int, Interval<0, 100>{}> a(Budget(95, runtime_check));
+
+    EXPECT_EQ(a.try_fetch_add(5)->get(), 95);
+    EXPECT_FALSE(a.try_fetch_add(1).has_value());
+    EXPECT_THROW((void)a.fetch_add(1), refinement_error);
+    EXPECT_EQ(a.load().get(), 100);
+
+    EXPECT_EQ(a.fetch_sub(60).get(), 100);
+    EXPECT_FALSE(a.try_fetch_sub(41).has_value());
+    EXPECT_EQ(a.load().get(), 40);
+
+    // Overflow of T is refused even if the interval would allow the result
+    AtomicRefined<int, Positive> p(Refined<int, Positive>(1, runtime_check));
+    p.store(Refined<int, Positive>(std::numeric_limits<int>::max(),
+                                   runtime_check));
+    EXPECT_FALSE(p.try_fetch_add(1).has_value());
+}
+
+TEST(AtomicRefined, Saturates) {
+    using Level = Refined<int, Interval<-10, 10>{}>;
+    AtomicRefined<int, Interval<-10, 10>{}> a(Level(8, runtime_check));
+    EXPECT_EQ(a.saturating_fetch_add(5).get(), 8);
+    EXPECT_EQ(a.load().get(), 10);
+    EXPECT_EQ(a.saturating_fetch_sub(std::numeric_limits<int>::max()).get(),
+              10);
+    EXPECT_EQ(a.load().get(), -10);
+}
+
+TEST(AtomicRefined, FullRangeIntervalUsesPlainAdd) {
+    using u32_limits = std::numeric_limits<std::uint32_t>;
+    constexpr auto Any32 = Interval<u32_limits::min(), u32_limits::max()>{};
+    static_assert(detail::accepts_all_values<std::uint32_t, Any32>());
+    static_assert(!detail::accepts_all_values<int, Interval<0, 100>{}>());
+
+    AtomicRefined<std::uint32_t, Any32> a(
+        Refined<std::uint32_t, Any32>(u32_limits::max(), runtime_check));
+    (void)a.fetch_add(1); // wraps like std::atomic; still satisfies Any32
+    EXPECT_EQ(a.load().get(), 0u);
+}
+
+TEST(AtomicRefined, ConcurrentIncrementsStopAtBound) {
+    using Slots = Refined<int, Interval<0, 1000>{}>;
+    AtomicRefined<int, Interval<0, 1000>{}> used(Slots(0, runtime_check));
+    std::atomic<int> granted{0};
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 8; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < 200; ++i) {
+                if (used.try_fetch_add(1)) {
+                    granted.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    EXPECT_EQ(granted.load(), 1000);
+    EXPECT_EQ(used.load().get(), 1000);
+}
+
+// ---- BoundedCounter Tests ----
+
+TEST(BoundedCounter, AcquireAndReleaseStayInBounds) {
+    BoundedCounter<int, 0, 10, 4> permits(IntervalRefined<int, 0, 10>{10});
+    EXPECT_TRUE(permits.acquire(7));
+    EXPECT_FALSE(permits.acquire(4)); // only 3 left; nothing is taken
+    EXPECT_EQ(permits.value().get(), 3);
+    EXPECT_EQ(permits.in_use().get(), 7);
+
+    EXPECT_TRUE(permits.release(7));
+    EXPECT_FALSE(permits.release(1)); // over-release is refused
+    EXPECT_EQ(permits.value().get(), 10);
+    EXPECT_FALSE(permits.acquire(-1));
+    EXPECT_FALSE(permits.acquire(11));
+}
+
+TEST(BoundedCounter, StealsAcrossShards) {
+    // 100 units spread over 8 shards; a single thread can still take them all
+    BoundedCounter<long, 0, 100, 8> bytes(IntervalRefined<long, 0L, 100L>{40});
+    EXPECT_TRUE(bytes.acquire(40));
+    EXPECT_EQ(bytes.available().get(), 0);
+    EXPECT_TRUE(bytes.release(25));
+    EXPECT_TRUE(bytes.acquire(25));
+    EXPECT_EQ(bytes.value().get(), 0);
+    static_assert(alignof(decltype(bytes)) >= detail::cache_line_size);
+}
+
+TEST(BoundedCounter, NonZeroLowerBound) {
+    BoundedCounter<int, 5, 8, 2> c(IntervalRefined<int, 5, 8>{8});
+    EXPECT_TRUE(c.acquire(3));
+    EXPECT_EQ(c.value().get(), 5);
+    EXPECT_FALSE(c.acquire(1));
+    static_assert(
+        std::same_as<decltype(c.value()), IntervalRefined<int, 5, 8>>);
+}
+
+TEST(BoundedCounter, ConcurrentAcquireRelease) {
+    BoundedCounter<int, 0, 64> limit(IntervalRefined<int, 0, 64>{64});
+    std::atomic<int> peak{0};
+    std::atomic<int> held{0};
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 8; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < 2000; ++i) {
+                if (limit.acquire(4)) {
+                    const int now = held.fetch_add(4) + 4;
+                    int prev = peak.load();
+                    while (now > prev &&
+                           !peak.compare_exchange_weak(prev, now)) {
+                    }
+                    held.fetch_sub(4);
+                    ASSERT_TRUE(limit.release(4));
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    EXPECT_LE(peak.load(), 64);
+    EXPECT_EQ(limit.value().get(), 64);
+    EXPECT_EQ(limit.in_use().get(), 0);
+}
+
+TEST(BoundedCounter, ReleaseNeverFailsSpuriously) {
+    // Mixed amounts over few shards keep steals and returned surplus in
+    // flight while other threads release
+    BoundedCounter<int, 0, 40, 3> limit(IntervalRefined<int, 0, 40>{40});
+    std::atomic<int> failed{0};
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 6; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < 3000; ++i) {
+                const int n = 1 + (i + t) % 9;
+                if (limit.acquire(n) && !limit.release(n)) {
+                    failed.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    EXPECT_EQ(failed.load(), 0);
+    EXPECT_EQ(limit.value().get(), 40);
+    EXPECT_FALSE(limit.release(1));
+}
+
+TEST(BoundedCounter, ReleaseOnAnotherThread) {
+    // Units acquired on one thread sit in that thread's in-use shard; the
+    // releasing threads have to gather them from there
+    BoundedCounter<int, 0, 32, 4> limit(IntervalRefined<int, 0, 32>{32});
+    for (int i = 0; i < 32; ++i) {
+        ASSERT_TRUE(limit.acquire(1));
+    }
+    std::atomic<int> failed{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < 4; ++i) {
+                if (!limit.release(2)) {
+                    failed.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    EXPECT_EQ(failed.load(), 0);
+    EXPECT_EQ(limit.in_use().get(), 0);
+    EXPECT_EQ(limit.value().get(), 32);
+    EXPECT_FALSE(limit.release(1));
+}
+
+// ---- Ring Buffer Tests ----
+
+TEST(RingBuffer, SpscWrapsWithMask) {
+    SpscRing<std::string> ring(RingCapacity{4});
+    EXPECT_EQ(ring.capacity(), 4u);
+    for (int lap = 0; lap < 3; ++lap) {
+        EXPECT_TRUE(ring.try_push("a"));
+        EXPECT_TRUE(ring.try_emplace(3, 'b'));
+        EXPECT_TRUE(ring.try_push("c"));
+        EXPECT_TRUE(ring.try_push("d"));
+        EXPECT_FALSE(ring.try_push("e"));
+        EXPECT_EQ(ring.try_pop(), "a");
+        EXPECT_EQ(ring.try_pop(), "bbb");
+        EXPECT_EQ(ring.try_pop(), "c");
+        EXPECT_EQ(ring.try_pop(), "d");
+        EXPECT_FALSE(ring.try_pop().has_value());
+    }
+    EXPECT_THROW((void)RingCapacity(6, runtime_check), refinement_error);
+}
+
+TEST(RingBuffer, SpscBatch) {
+    SpscRing<int> ring(RingCapacity{8});
+    std::vector<int> in{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    EXPECT_EQ(ring.try_push_n(in), 8u);
+    std::vector<int> out(5);
+    EXPECT_EQ(ring.try_pop_n(out), 5u);
+    EXPECT_EQ(out, (std::vector<int>{1, 2, 3, 4, 5}));
+    EXPECT_EQ(ring.try_push_n(std::span<const int>(in).subspan(8)), 2u);
+    EXPECT_EQ(ring.size(), 5u);
+    EXPECT_EQ(ring.try_pop_n(out), 5u);
+    EXPECT_EQ(out, (std::vector<int>{6, 7, 8, 9, 10}));
+}
+
+TEST(RingBuffer, SpscThreadedOrder) {
+    SpscRing<int> ring(RingCapacity{64});
+    constexpr int count = 100'000;
+    std::thread producer([&] {
+        for (int i = 0; i < count;) {
+            if (ring.try_push(i)) {
+                ++i;
+            }
+        }
+    });
+    long long sum = 0;
+    int expected = 0;
+    bool ordered = true;
+    while (expected < count) {
+        if (auto v = ring.try_pop()) {
+            ordered &= *v == expected++;
+            sum += *v;
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(sum, static_cast<long long>(count) * (count - 1) / 2);
+}
+
+TEST(RingBuffer, MpmcDeliversEveryElementOnce) {
+    MpmcRing<int> ring(RingCapacity{128});
+    EXPECT_THROW(MpmcRing<int>(RingCapacity{1}), std::invalid_argument);
+
+    constexpr int per_producer = 20'000;
+    constexpr int producers = 4;
+    std::atomic<long long> sum{0};
+    std::atomic<int> popped{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < per_producer;) {
+                if (ring.try_push(p * per_producer + i)) {
+                    ++i;
+                }
+            }
+        });
+        threads.emplace_back([&] {
+            std::array<int, 16> batch;
+            while (popped.load() < producers * per_producer) {
+                const auto n = ring.try_pop_n(batch);
+                for (std::size_t i = 0; i < n; ++i) {
+                    sum.fetch_add(batch[i]);
+                }
+                popped.fetch_add(static_cast<int>(n));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    constexpr long long total = producers * per_producer;
+    EXPECT_EQ(popped.load(), total);
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+    EXPECT_TRUE(ring.empty());
+}
+
+// ---- Snapshot Tests ----
+
+namespace {
+
+struct ServerConfig {
+    IntervalRefined<int, 1, 65535> port;
+    Refined<int, Positive> max_connections;
+    int reserved_connections = 0;
+};
+
+inline constexpr auto ReservedFits = [](const ServerConfig& c) {
+    return c.reserved_connections <= c.max_connections.get();
+};
+
+// Counts live instances to observe reclamation
+struct Tracked {
+    static inline std::atomic<int> live{0};
+    int value = 0;
+    explicit Tracked(int v) : value(v) { ++live; }
+    Tracked(const Tracked& other) : value(other.value) { ++live; }
+    Tracked& operator=(const Tracked&) = default;
+    ~Tracked() { --live; }
+};
+
+} // namespace
+
+TEST(Snapshot, PublishValidatesOnce) {
+    refined_snapshot<ServerConfig, ReservedFits> config(
+        ServerConfig{IntervalRefined<int, 1, 65535>{8080},
+                     Refined<int, Positive>{100}, 10},
+        runtime_check);
+    {
+        auto cfg = config.read();
+        EXPECT_EQ(cfg->port.get(), 8080);
+        EXPECT_EQ(cfg->max_connections.get(), 100);
+    }
+
+    const ServerConfig overbooked{IntervalRefined<int, 1, 65535>{1},
+                                  Refined<int, Positive>{5}, 6};
+    EXPECT_THROW(config.publish(overbooked), refinement_error);
+    EXPECT_EQ(config.read()->port.get(), 8080);
+
+    config.update([](ServerConfig& c) {
+        c.port = IntervalRefined<int, 1, 65535>{9090};
+    });
+    EXPECT_EQ(config.load()->port.get(), 9090);
+    const auto overbook = [](ServerConfig& c) {
+        c.reserved_connections = 1000;
+    };
+    EXPECT_THROW(config.update(overbook), refinement_error);
+    EXPECT_EQ(config.read()->reserved_connections, 10);
+}
+
+TEST(Snapshot, ReaderKeepsOldSnapshotAlive) {
+    epoch_domain::global().synchronize();
+    const int before = Tracked::live.load();
+    {
+        refined_snapshot<Tracked> snap(Refined<Tracked, Always>(Tracked(1),
+                                                                assume_valid));
+        auto old = snap.read();
+        snap.publish(Tracked(2));
+        snap.publish(Tracked(3));
+
+        // Both replaced snapshots are retired but pinned by `old`
+        EXPECT_GT(epoch_domain::global().collect(), 0u);
+        EXPECT_EQ(old->value, 1);
+        EXPECT_EQ(snap.read()->value, 3);
+    }
+    epoch_domain::global().synchronize();
+    EXPECT_EQ(Tracked::live.load(), before);
+}
+
+TEST(Snapshot, ConcurrentReadersAndWriter) {
+    refined_snapshot<ServerConfig, ReservedFits> config(
+        ServerConfig{IntervalRefined<int, 1, 65535>{1},
+                     Refined<int, Positive>{1}, 0},
+        runtime_check);
+    std::atomic<bool> done{false};
+    std::atomic<bool> consistent{true};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                auto cfg = config.read();
+                // Writer keeps port == max_connections in every snapshot
+                if (cfg->port.get() != cfg->max_connections.get()) {
+                    consistent = false;
+                }
+            }
+        });
+    }
+    for (int i = 2; i <= 2000; ++i) {
+        config.publish(ServerConfig{IntervalRefined<int, 1, 65535>(
+                                        i, runtime_check),
+                                    Refined<int, Positive>(i, runtime_check),
+                                    0});
+    }
+    done = true;
+    for (auto& r : readers) {
+        r.join();
+    }
+    EXPECT_TRUE(consistent.load());
+    EXPECT_EQ(config.read()->port.get(), 2000);
+}
+
+// ---- Predicate Registry Tests ----
+
+TEST(PredicateRegistry, RegisterFindAndCheck) {
+    runtime::PredicateRegistry<int> registry;
+    const auto small = registry.register_predicate(
+        "tenant-a/limit", runtime::AllOf<int>(Positive, LessThan(100)));
+    const auto even = registry.register_predicate("even", Even);
+
+    EXPECT_EQ(registry.find("tenant-a/limit"), small);
+    EXPECT_FALSE(registry.find("tenant-b/limit").has_value());
+    EXPECT_EQ(registry.name(even), "even");
+    EXPECT_EQ(registry.size(), 2u);
+
+    EXPECT_TRUE(registry.check(small, 42));
+    EXPECT_FALSE(registry.check(small, 142));
+    EXPECT_NO_THROW(registry.validate(even, 4));
+    try {
+        registry.validate(small, 0);
+        FAIL() << "expected refinement_error";
+    } catch (const refinement_error& e) {
+        EXPECT_NE(std::string(e.what()).find("tenant-a/limit"),
+                  std::string::npos);
+    }
+    EXPECT_THROW((void)registry.check(runtime::predicate_id{7}, 1),
+                 std::out_of_range);
+}
+
+TEST(PredicateRegistry, HotSwapAndGrowthKeepIds) {
+    runtime::PredicateRegistry<int> registry;
+    const auto limit = registry.register_predicate("limit", LessThan(10));
+    EXPECT_FALSE(registry.check(limit, 50));
+
+    registry.replace(limit, LessThan(100));
+    EXPECT_TRUE(registry.check(limit, 50));
+    // Re-registering a name swaps the predicate and keeps the id
+    EXPECT_EQ(registry.register_predicate("limit", LessThan(20)), limit);
+    EXPECT_FALSE(registry.check(limit, 50));
+
+    // Grow past the initial slot array
+    std::vector<runtime::predicate_id> ids;
+    for (int i = 0; i < 100; ++i) {
+        ids.push_back(registry.register_predicate(
+            "le-" + std::to_string(i), LessOrEqual(i)));
+    }
+    EXPECT_TRUE(registry.check(ids[99], 99));
+    EXPECT_FALSE(registry.check(ids[3], 4));
+    EXPECT_FALSE(registry.check(limit, 50));
+}
+
+TEST(PredicateRegistry, ConcurrentChecksDuringSwaps) {
+    runtime::PredicateRegistry<int> registry;
+    const auto id = registry.register_predicate("bound", LessThan(1000));
+    std::atomic<bool> done{false};
+    std::atomic<long> accepted{0};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                accepted += registry.check(id, 5) ? 1 : 0;
+            }
+        });
+    }
+    for (int i = 0; i < 500; ++i) {
+        registry.replace(id, LessThan(i % 2 == 0 ? 1000 : 10));
+        (void)registry.register_predicate("extra-" + std::to_string(i),
+                                          Positive);
+    }
+    done = true;
+    for (auto& r : readers) {
+        r.join();
+    }
+    EXPECT_EQ(registry.size(), 501u);
+    EXPECT_TRUE(registry.check(id, 5));
+}
+
+// ---- Static Data Tests ----
+
+TEST(StaticData, RefineArray) {
+    constexpr std::array<int, 5> raw{1, 2, 3, 5, 8};
+    constexpr auto table = refine_array<Positive>(raw);
+    static_assert(std::same_as<decltype(table),
+                               const std::array<Refined<int, Positive>, 5>>);
+    static_assert(table[4].get() == 8);
+    EXPECT_EQ(table[0].get(), 1);
+
+    constexpr auto percents =
+        refine_array<Interval<0, 100>{}>(std::array<int, 3>{0, 50, 100});
+    static_assert(percents[1].get() == 50);
+}
+
+TEST(StaticData, RefineEmbeddedBytes) {
+    // Stand-in for `#embed`: 3 little-endian uint16_t values 1, 2, 256
+    static constexpr unsigned char blob[] = {0x01, 0x00, 0x02,
+                                             0x00, 0x00, 0x01};
+    constexpr auto ports = refine_bytes<std::uint16_t, Positive>(blob);
+    static_assert(ports.size() == 3);
+    if constexpr (std::endian::native == std::endian::little) {
+        EXPECT_EQ(ports[2].get(), 256);
+    }
+
+    constexpr std::array<std::byte, 4> word{std::byte{1}, std::byte{0},
+                                            std::byte{0}, std::byte{0}};
+    constexpr auto ones = refine_bytes<std::uint32_t, NonZero>(word);
+    EXPECT_EQ(ones.size(), 1u);
+}
+
+// ---- Envelope Tests ----
+
+TEST(Envelope, SealAndAdoptWithoutRevalidation) {
+    RefinedVector<int, Positive> sizes(std::vector<int>{3, 1, 4, 1, 5, 9, 2, 6},
+                                       runtime_check);
+    const std::vector<std::byte> wire = seal(sizes);
+    EXPECT_EQ(wire.size(), envelope_size<int>(sizes.size()));
+
+    const auto adopted = open_envelope<int, Positive>(wire);
+    static_assert(std::same_as<decltype(adopted),
+                               const std::span<const Refined<int, Positive>>>);
+    ASSERT_EQ(adopted.size(), 8u);
+    EXPECT_EQ(adopted[5].get(), 9);
+
+    const auto empty = seal(std::span<const Refined<int, Positive>>{});
+    EXPECT_TRUE((open_envelope<int, Positive>(empty).empty()));
+}
+
+TEST(Envelope, RejectsCorruptedOrForeignBuffers) {
+    RefinedVector<int, Positive> ids(std::vector<int>(100, 7), runtime_check);
+    std::vector<std::byte> wire = seal(ids);
+
+    auto corrupted = wire;
+    corrupted.back() ^= std::byte{0x01};
+    EXPECT_FALSE((try_open_envelope<int, Positive>(corrupted)));
+    EXPECT_THROW(((void)open_envelope<int, Positive>(corrupted)),
+                 refinement_error);
+
+    const std::span<const std::byte> truncated(wire.data(), wire.size() - 4);
+    EXPECT_FALSE((try_open_envelope<int, Positive>(truncated)));
+
+    // Same bytes read back as a different element type
+    EXPECT_FALSE((try_open_envelope<std::int16_t, Positive>(wire)));
+    EXPECT_TRUE((try_open_envelope<int, Positive>(wire)));
+}
+
+TEST(Envelope, DistinguishesClosurePredicates) {
+    static_assert(predicate_fingerprint<int, Positive> !=
+                  predicate_fingerprint<int, Negative>);
+    static_assert(predicate_fingerprint<int, Positive> !=
+                  predicate_fingerprint<int, NonZero>);
+    static_assert(predicate_fingerprint<int, NonNegative> !=
+                  predicate_fingerprint<int, NonPositive>);
+
+    RefinedVector<int, Positive> ids(std::vector<int>{1, 2, 3}, runtime_check);
+    const std::vector<std::byte> wire = seal(ids);
+    EXPECT_FALSE((try_open_envelope<int, Negative>(wire)));
+    EXPECT_THROW(((void)open_envelope<int, Negative>(wire)), refinement_error);
+    EXPECT_TRUE((try_open_envelope<int, Positive>(wire)));
+}
+
+TEST(Envelope, FingerprintsCapturedState) {
+    static_assert(predicate_fingerprint<int, InRange(0, 500)> !=
+                  predicate_fingerprint<int, InRange(0, 600)>);
+    static_assert(predicate_fingerprint<int, InRange(0, 500)> ==
+                  predicate_fingerprint<int, InRange(0, 500)>);
+    static_assert(predicate_fingerprint<int, Interval<0, 500>{}> !=
+                  predicate_fingerprint<int, Interval<0, 600>{}>);
+
+    RefinedVector<int, InRange(0, 500)> levels(std::vector<int>{10, 450},
+                                               runtime_check);
+    const std::vector<std::byte> wire = seal(levels);
+    EXPECT_FALSE((try_open_envelope<int, InRange(0, 600)>(wire)));
+    EXPECT_TRUE((try_open_envelope<int, InRange(0, 500)>(wire)));
+}
+
+TEST(Envelope, SealIntoCallerBuffer) {
+    const std::array<Refined<double, Positive>, 2> values{
+        Refined<double, Positive>(0.5, runtime_check),
+        Refined<double, Positive>(2.0, runtime_check)};
+    const std::span<const Refined<double, Positive>> view(values);
+    alignas(8) std::array<std::byte, 64> shm{};
+    EXPECT_THROW((void)seal_into(view,
+                                 std::span<std::byte>(shm).first(40)),
+                 std::length_error);
+    EXPECT_EQ(seal_into(view, std::span<std::byte>(shm)), 48u);
+    EXPECT_EQ((open_envelope<double, Positive>(shm)[1].get()), 2.0);
+}
+
+// ---- Core Header Tests ----
+
+namespace {
+
+struct Version {
+    int major;
+    int minor;
+};
+
+struct Opaque {};
+
+} // namespace
+
+template <> struct std::formatter<Version> : std::formatter<std::string> {
+    auto format(const Version& v, auto& ctx) const {
+        return std::formatter<std::string>::format(
+            std::format("v{}.{}", v.major, v.minor), ctx);
+    }
+};
+
+TEST(CoreHeader, RefinementErrorMessages) {
+    auto message = [](auto&& make) {
+        try {
+            make();
+        } catch (const refinement_error& e) {
+            return std::string(e.what());
+        }
+        return std::string();
+    };
+    EXPECT_EQ(message([] { PositiveI32(-7, runtime_check); }),
+              "Refinement violation: -7 does not satisfy predicate");
+    EXPECT_EQ(message([] { Refined<double, Positive>(-0.25, runtime_check); }),
+              "Refinement violation: -0.25 does not satisfy predicate");
+    EXPECT_EQ(message([] {
+                  Refined<std::string_view, NonEmpty>("", runtime_check);
+              }),
+              "Refinement violation:  does not satisfy predicate");
+    EXPECT_EQ(message([] { throw refinement_error(PositiveI32{3}, "Even"); }),
+              "Refinement violation: 3 does not satisfy Even");
+    EXPECT_EQ(message([] { throw refinement_error(Version{2, 1}, "Stable"); }),
+              "Refinement violation: v2.1 does not satisfy Stable");
+    EXPECT_EQ(message([] { throw refinement_error(Opaque{}); }),
+              "Refinement violation: value does not satisfy predicate");
+}
+
+TEST(CoreHeader, TransformWithMemberFunction) {
+    const Refined<std::string, NonEmpty> name("refinery", runtime_check);
+    auto length = transform_refined<Positive>(name, &std::string::size);
+    EXPECT_EQ(length.get(), 8u);
+}
+
+// ---- Generator Tests ----
+
+TEST(Generate, IntervalIsUniformAndDirect) {
+    using Digit = IntervalRefined<int, 0, 9>;
+    static_assert(direct_sampling<Digit>);
+    std::mt19937_64 rng(1);
+    std::vector<int> values(10'000);
+    generate<Digit>(rng, values);
+
+    std::array<int, 10> counts{};
+    for (int v : values) {
+        ASSERT_TRUE(Digit::is_valid(v));
+        ++counts[static_cast<std::size_t>(v)];
+    }
+    for (int c : counts) {
+        EXPECT_GT(c, 800);
+        EXPECT_LT(c, 1200);
+    }
+}
+
+TEST(Generate, StructuralPredicatesConstructValues) {
+    static_assert(direct_sampling<PositiveI32>);
+    static_assert(direct_sampling<Refined<std::int64_t, Even>>);
+    static_assert(direct_sampling<Refined<std::uint32_t, PowerOfTwo>>);
+    static_assert(direct_sampling<Refined<double, Normalized>>);
+    static_assert(!direct_sampling<Refined<double, NonZero>>);
+
+    std::mt19937_64 rng(2);
+    std::vector<std::int64_t> values(1000);
+    generate<Refined<std::int64_t, Odd>>(rng, values);
+    for (auto v : values) {
+        EXPECT_TRUE(Odd(v));
+    }
+
+    std::vector<std::int8_t> small(1000);
+    generate<Refined<std::int8_t, NonZero>>(rng, small);
+    for (auto v : small) {
+        EXPECT_NE(v, 0);
+    }
+}
+
+TEST(Generate, OpaquePredicateUsesRejection) {
+    constexpr auto Mod3 = [](int v) { return v % 3 == 0; };
+    using Multiple = Refined<int, All<Positive, Mod3>>;
+    static_assert(!direct_sampling<Multiple>);
+
+    std::mt19937_64 rng(3);
+    std::vector<int> values(1000);
+    generate<Multiple>(rng, values);
+    for (int v : values) {
+        EXPECT_TRUE(Multiple::is_valid(v));
+    }
+
+    std::vector<int> never(1);
+    EXPECT_THROW(
+        (generate<Refined<int, Never>>(rng, never, {.max_rejections = 1024})),
+        refinement_error);
+}
+
+TEST(Generate, InvalidFractionIsExact) {
+    std::mt19937_64 rng(4);
+    std::vector<double> values(1000);
+    generate<IntervalRefined<double, 0.0, 1.0>>(rng, values,
+                                                {.invalid_fraction = 0.25});
+    const auto invalid =
+        std::count_if(values.begin(), values.end(),
+                      [](double v) { return !(v >= 0.0 && v <= 1.0); });
+    EXPECT_EQ(invalid, 250);
+
+    std::vector<int> all_bad(100);
+    generate<Refined<int, Even>>(rng, all_bad, {.invalid_fraction = 1.0});
+    for (int v : all_bad) {
+        EXPECT_FALSE(Even(v));
+    }
+
+    std::vector<std::uint8_t> bytes(10);
+    EXPECT_THROW((generate<Refined<std::uint8_t, Always>>(
+                     rng, bytes, {.invalid_fraction = 0.5})),
+                 refinement_error);
+    EXPECT_THROW(generate<PositiveI32>(rng, all_bad, {.invalid_fraction = 2}),
+                 std::invalid_argument);
+}
+
+TEST(Generate, IntervalBoundsClampToType) {
+    static_assert(detail::ceil_to<std::uint8_t>(-5) == 0);
+    static_assert(detail::floor_to<std::uint8_t>(300) == 255);
+    static_assert(detail::floor_to<std::int64_t>(1e19) ==
+                  std::numeric_limits<std::int64_t>::max());
+
+    std::mt19937_64 rng(6);
+    std::vector<std::uint8_t> bytes(25'600);
+    generate<IntervalRefined<std::uint8_t, 0, 300>>(rng, bytes);
+    std::array<int, 256> counts{};
+    for (auto v : bytes) {
+        ++counts[v];
+    }
+    for (int c : counts) {
+        EXPECT_GT(c, 50);
+        EXPECT_LT(c, 150);
+    }
+
+    using Small = IntervalRefined<std::uint16_t, -5, 10>;
+    std::vector<std::uint16_t> small(1000);
+    generate<Small>(rng, small);
+    for (auto v : small) {
+        EXPECT_TRUE(Small::is_valid(v));
+    }
+    EXPECT_NE(std::ranges::find(small, 0), small.end());
+
+    using Beyond = IntervalRefined<std::uint8_t, 300, 400>;
+    EXPECT_THROW(generate<Beyond>(rng, bytes), refinement_error);
+    generate<Beyond>(rng, bytes, {.invalid_fraction = 1.0});
+}
+
+TEST(Generate, InvalidFloatsAreRejectedByThePredicate) {
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    std::mt19937_64 rng(7);
+    std::vector<double> values(200);
+
+    EXPECT_THROW((generate<Refined<double, Always>>(
+                     rng, values, {.invalid_fraction = 0.5})),
+                 refinement_error);
+
+    generate<Refined<double, NonNegative>>(rng, values,
+                                           {.invalid_fraction = 1.0});
+    for (double v : values) {
+        EXPECT_LT(v, 0.0);
+    }
+
+    generate<IntervalRefined<double, -inf, 1.0>>(rng, values,
+                                                 {.invalid_fraction = 1.0});
+    for (double v : values) {
+        EXPECT_GT(v, 1.0);
+        EXPECT_NE(v, inf);
+    }
+
+    generate<Refined<double, Finite>>(rng, values, {.invalid_fraction = 1.0});
+    for (double v : values) {
+        EXPECT_TRUE(std::isinf(v));
+    }
+}
+
+TEST(Generate, RefinedOutput) {
+    std::mt19937 rng(5);
+    std::vector<PositiveI32> out;
+    for (int i = 0; i < 64; ++i) {
+        out.emplace_back(1, assume_valid);
+    }
+    generate<PositiveI32>(rng, std::span<PositiveI32>(out));
+    for (const auto& r : out) {
+        EXPECT_GT(r.get(), 0);
+    }
+}